@@ -0,0 +1,941 @@
+/** \file benchmark.cpp
+    \brief Micro-benchmarks for the int_mod library.
+    \details Build with optimisations from a directory containing math_nerd/ with the headers, e.g.
+             g++ -std=c++20 -O2 -march=native -I<include dir> benchmark.cpp -o benchmark
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <math_nerd/discrete_log.h>
+#include <math_nerd/exponentiation.h>
+#include <math_nerd/int_mod.h>
+#include <math_nerd/int_mod_accumulator.h>
+#include <math_nerd/int_mod_vector.h>
+#include <math_nerd/matrix.h>
+#include <math_nerd/montgomery_int_mod.h>
+#include <math_nerd/ntt.h>
+#include <math_nerd/polynomial.h>
+#include <math_nerd/rns.h>
+
+namespace im = math_nerd::int_mod;
+
+namespace
+{
+    /** \var sink
+        \brief Benchmarked results are accumulated here so the optimiser cannot discard them.
+     */
+    volatile im::s64 sink{ 0 };
+
+    /** \fn auto ns_per_op(F &&f, std::size_t const ops) -> double
+        \brief Runs f once and returns the elapsed time divided by ops, in nanoseconds.
+     */
+    template <typename F>
+    auto ns_per_op(F &&f, std::size_t const ops) -> double
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const stop = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(ops);
+    }
+
+    /** \fn auto report(std::string const &name, double const ns) -> void
+        \brief Prints one benchmark result.
+     */
+    auto report(std::string const &name, double const ns) -> void
+    {
+        std::cout << std::left << std::setw(56) << name << std::right << std::setw(10) << std::fixed
+                  << std::setprecision(2) << ns << " ns/op\n";
+    }
+
+    /** \fn auto random_residues(im::s64 const n, std::size_t const count) -> std::vector<im::s64>
+        \brief Returns count uniformly random residues in [1, n) from a fixed seed.
+     */
+    auto random_residues(im::s64 const n, std::size_t const count) -> std::vector<im::s64>
+    {
+        std::mt19937_64 gen{ 20200101 };
+        std::uniform_int_distribution<im::s64> dist{ 1, n - 1 };
+        std::vector<im::s64> res(count);
+
+        for( auto &x : res )
+        {
+            x = dist(gen);
+        }
+
+        return res;
+    }
+
+    /** \fn auto bench_inverse() -> void
+        \brief Compares inverse_of<N> (extended Euclid) against Euler's theorem, \f$a^{\phi(N)-1}\f$.
+     */
+    template <im::s64 N, im::s64 Phi>
+    auto bench_inverse() -> void
+    {
+        constexpr std::size_t count{ 1 << 16 };
+        auto const inputs = random_residues(N, count);
+
+        auto const euler = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : inputs )
+            {
+                if( im::impl_details::gcd(x, N) == 1 )
+                {
+                    acc += im::impl_details::ipow<N>(x, Phi - 1);
+                }
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const euclid = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : inputs )
+            {
+                acc += im::impl_details::gcd_and_inverse(x, N).second;
+            }
+            sink = sink + acc;
+        }, count);
+
+        report("inverse, Euler phi:       N = " + std::to_string(N), euler);
+        report("inverse, extended Euclid: N = " + std::to_string(N), euclid);
+    }
+
+    /** \fn auto bench_prime_inverse() -> void
+        \brief Compares Fermat's \f$a^{N-2}\f$ and extended Euclid against int_mod<N>::inverse() for a prime N.
+     */
+    template <im::s64 N>
+    auto bench_prime_inverse() -> void
+    {
+        using F = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 16 };
+        auto const inputs = random_residues(N, count);
+
+        auto const fermat = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : inputs )
+            {
+                acc += im::impl_details::pow_unrolled<static_cast<im::u64>(N - 2)>(F{ x }, F{ 1 }).value();
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const euclid = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : inputs )
+            {
+                acc += im::impl_details::gcd_and_inverse(x, N).second;
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const dispatched = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : inputs )
+            {
+                acc += F{ x }.inverse();
+            }
+            sink = sink + acc;
+        }, count);
+
+        report("prime inverse, Fermat:    N = " + std::to_string(N), fermat);
+        report("prime inverse, Euclid:    N = " + std::to_string(N), euclid);
+        report("prime inverse, inverse(): N = " + std::to_string(N), dispatched);
+    }
+
+    /** \fn auto bench_batch_inverse() -> void
+        \brief Compares batch_inverse() against inverting each int_mod<N> on its own.
+     */
+    template <im::s64 N>
+    auto bench_batch_inverse() -> void
+    {
+        constexpr std::size_t count{ 1 << 16 };
+        auto const inputs = random_residues(N, count);
+        std::vector<im::int_mod<N>> values(inputs.begin(), inputs.end());
+
+        auto const single = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : values )
+            {
+                acc += x.inverse();
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const batch = ns_per_op([&]
+        {
+            sink = sink + static_cast<im::s64>(im::batch_inverse(std::span{ values }));
+        }, count);
+
+        report("inverse(), one at a time:  N = " + std::to_string(N), single);
+        report("batch_inverse():           N = " + std::to_string(N), batch);
+    }
+
+    /** \fn auto bench_sqrt() -> void
+        \brief Compares batch_sqrt() against calling int_mod<N>::sqrt() on each value, half of which are squares.
+     */
+    template <im::s64 N>
+    auto bench_sqrt() -> void
+    {
+        using T = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 14 };
+        auto const inputs = random_residues(N, count);
+        std::vector<T> values(inputs.begin(), inputs.end());
+
+        for( std::size_t i{ 0 }; i < count; i += 2 )
+        {
+            values[i] *= values[i];
+        }
+
+        auto const single = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : values )
+            {
+                acc += x.sqrt().value_or(T{ 0 }).value();
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const batch = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const root : im::batch_sqrt(values) )
+            {
+                acc += root.value_or(T{ 0 }).value();
+            }
+            sink = sink + acc;
+        }, count);
+
+        report("sqrt(), one at a time:     N = " + std::to_string(N), single);
+        report("batch_sqrt():              N = " + std::to_string(N), batch);
+    }
+
+    /** \fn auto bench_jacobi() -> void
+        \brief Compares Euler's criterion, jacobi() and vector_jacobi() for testing quadratic residuosity modulo N.
+     */
+    template <im::s64 N>
+    auto bench_jacobi() -> void
+    {
+        using T = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 16 };
+        auto const inputs = random_residues(N, count);
+        std::vector<T> const values(inputs.begin(), inputs.end());
+        std::vector<int> out(count);
+
+        auto const euler = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : values )
+            {
+                acc += x.template pow<(N - 1) / 2>().value();
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const binary = ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const x : values )
+            {
+                acc += im::jacobi(x);
+            }
+            sink = sink + acc;
+        }, count);
+
+        auto const vectorised = ns_per_op([&]
+        {
+            im::vector_jacobi(values, std::span{ out });
+            sink = sink + out.back();
+        }, count);
+
+        report("Euler's criterion:         N = " + std::to_string(N), euler);
+        report("jacobi():                  N = " + std::to_string(N), binary);
+        report("vector_jacobi():           N = " + std::to_string(N), vectorised);
+    }
+
+    /** \fn auto bench_discrete_log(im::s64 const g, std::size_t const count) -> void
+        \brief Times discrete_log_solver<N> for the base g, with the default table budget and with no tables, where
+               Pollard's rho handles every prime above 2^10.
+     */
+    template <im::s64 N>
+    auto bench_discrete_log(im::s64 const g, std::size_t const count) -> void
+    {
+        using T = im::int_mod<N>;
+
+        auto const exponents = random_residues(N, count);
+
+        for( auto const &[budget, name] : { std::pair{ std::size_t{ 1 } << 20, std::string{ "tables" } }, std::pair{ std::size_t{ 0 }, std::string{ "rho" } } } )
+        {
+            std::optional<im::discrete_log_solver<N>> solver;
+
+            auto const setup = ns_per_op([&]
+            {
+                solver.emplace(T{ g }, budget);
+            }, 1);
+
+            std::vector<T> targets;
+
+            for( auto const x : exponents )
+            {
+                targets.push_back(T{ g }.pow(x));
+            }
+
+            auto const solve = ns_per_op([&]
+            {
+                im::s64 acc{ 0 };
+                for( auto const h : targets )
+                {
+                    acc += solver->solve(h).value_or(-1);
+                }
+                sink = sink + acc;
+            }, count);
+
+            std::string const suffix{ name + ": N = " + std::to_string(N) };
+
+            report("discrete_log setup, " + suffix, setup);
+            report("discrete_log solve, " + suffix, solve);
+        }
+    }
+
+    /** \fn auto bench_dot() -> void
+        \brief Compares dot() against summing int_mod<N> products with operator+=, per product.
+     */
+    template <im::s64 N>
+    auto bench_dot() -> void
+    {
+        using T = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 16 };
+        auto const raw_a = random_residues(N, count);
+        auto const raw_b = random_residues(N, count);
+        std::vector<T> const a(raw_a.begin(), raw_a.end());
+        std::vector<T> const b(raw_b.begin(), raw_b.end());
+
+        auto const eager = ns_per_op([&]
+        {
+            T sum{ 0 };
+            for( std::size_t i{ 0 }; i < count; ++i )
+            {
+                sum += a[i] * b[i];
+            }
+            sink = sink + sum.value();
+        }, count);
+
+        auto const lazy = ns_per_op([&]
+        {
+            sink = sink + im::dot(std::span<T const>{ a }, b).value();
+        }, count);
+
+        report("dot, int_mod<N> operators: N = " + std::to_string(N), eager);
+        report("dot(), lazy accumulator:   N = " + std::to_string(N), lazy);
+    }
+
+    /** \fn auto bench_shoup() -> void
+        \brief Compares multiplying many int_mod<N> by one factor with int_mod<N> operator* and with shoup_multiplier<N>.
+     */
+    template <im::s64 N>
+    auto bench_shoup() -> void
+    {
+        using T = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 16 };
+        auto const raw = random_residues(N, count + 1);
+        std::vector<T> values(raw.begin(), raw.end() - 1);
+        T const w{ raw.back() };
+        im::shoup_multiplier<N> const factor{ w };
+
+        auto const native = ns_per_op([&]
+        {
+            for( auto &x : values )
+            {
+                x *= w;
+            }
+            sink = sink + values[0].value();
+        }, count);
+
+        auto const shoup = ns_per_op([&]
+        {
+            for( auto &x : values )
+            {
+                x *= factor;
+            }
+            sink = sink + values[0].value();
+        }, count);
+
+        report("x * w, int_mod<N>:         N = " + std::to_string(N), native);
+        report("x * w, shoup_multiplier:   N = " + std::to_string(N), shoup);
+    }
+
+    /** \fn auto naive_multiply(std::vector<im::u32> const &a, std::vector<im::u32> const &b) -> std::vector<im::u32>
+        \brief Schoolbook product of two little-endian 32-bit limb vectors, the baseline for bench_rns().
+     */
+    auto naive_multiply(std::vector<im::u32> const &a, std::vector<im::u32> const &b) -> std::vector<im::u32>
+    {
+        std::vector<im::u32> c(a.size() + b.size(), 0);
+
+        for( std::size_t i{ 0 }; i < a.size(); ++i )
+        {
+            im::u64 carry{ 0 };
+
+            for( std::size_t j{ 0 }; j < b.size(); ++j )
+            {
+                im::u64 const t{ static_cast<im::u64>(a[i]) * b[j] + c[i + j] + carry };
+                c[i + j] = static_cast<im::u32>(t);
+                carry = t >> 32;
+            }
+
+            c[i + b.size()] = static_cast<im::u32>(carry);
+        }
+
+        return c;
+    }
+
+    /** \fn auto naive_add(std::vector<im::u32> &a, std::vector<im::u32> const &b) -> void
+        \brief Adds b to a, growing a as needed.
+     */
+    auto naive_add(std::vector<im::u32> &a, std::vector<im::u32> const &b) -> void
+    {
+        a.resize(std::max(a.size(), b.size()) + 1, 0);
+        im::u64 carry{ 0 };
+
+        for( std::size_t i{ 0 }; i < a.size(); ++i )
+        {
+            im::u64 const t{ static_cast<im::u64>(a[i]) + (i < b.size() ? b[i] : 0) + carry };
+            a[i] = static_cast<im::u32>(t);
+            carry = t >> 32;
+        }
+
+        while( a.size() > 1 && a.back() == 0 )
+        {
+            a.pop_back();
+        }
+    }
+
+    /** \fn auto bench_rns() -> void
+        \brief Compares rns<N...> over five 62-bit primes against a naive bignum on a sum of products of four
+                62-bit integers. Times are per four-term product; the sums are checked against each other modulo 10^9 + 7.
+     */
+    auto bench_rns() -> void
+    {
+        using R = im::rns<4611686018427387847, 4611686018427387817, 4611686018427387787, 4611686018427387761, 4611686018427387751>;
+
+        constexpr std::size_t count{ 1 << 14 };
+        auto const inputs = random_residues(4611686018427387847, 4 * count);
+
+        std::vector<R> residues(inputs.begin(), inputs.end());
+        std::vector<std::vector<im::u32>> limbs;
+
+        for( auto const x : inputs )
+        {
+            limbs.push_back({ static_cast<im::u32>(x), static_cast<im::u32>(x >> 32) });
+        }
+
+        im::int_mod<1000000007> rns_check, naive_check;
+
+        auto const rns_time = ns_per_op([&]
+        {
+            R acc{ 0 };
+            for( std::size_t i{ 0 }; i < 4 * count; i += 4 )
+            {
+                acc += residues[i] * residues[i + 1] * residues[i + 2] * residues[i + 3];
+            }
+            rns_check = acc.reduce<1000000007>();
+        }, count);
+
+        auto const naive_time = ns_per_op([&]
+        {
+            std::vector<im::u32> acc{ 0 };
+            for( std::size_t i{ 0 }; i < 4 * count; i += 4 )
+            {
+                naive_add(acc, naive_multiply(naive_multiply(naive_multiply(limbs[i], limbs[i + 1]), limbs[i + 2]), limbs[i + 3]));
+            }
+            for( std::size_t k{ acc.size() }; k-- > 0; )
+            {
+                naive_check = naive_check * im::int_mod<1000000007>{ im::s64{ 1 } << 32 } + im::int_mod<1000000007>{ acc[k] };
+            }
+        }, count);
+
+        report("sum of 4-products, rns<5 x 62 bits>:", rns_time);
+        report("sum of 4-products, naive bignum:", naive_time);
+
+        if( rns_check != naive_check )
+        {
+            std::cerr << "rns and naive bignum results differ\n";
+        }
+    }
+
+    /** \fn auto bench_fixed_base_pow(std::string const &name) -> void
+        \brief Compares fixed_base_pow<T> at several window widths against pow() for random 63-bit exponents.
+     */
+    template <typename T>
+    auto bench_fixed_base_pow(std::string const &name) -> void
+    {
+        constexpr std::size_t count{ 1 << 15 };
+        auto const exponents = random_residues(INT64_MAX, count);
+        T const g{ 3 };
+
+        report("pow():                     " + name, ns_per_op([&]
+        {
+            im::s64 acc{ 0 };
+            for( auto const e : exponents )
+            {
+                acc += g.pow(e).value();
+            }
+            sink = sink + acc;
+        }, count));
+
+        for( auto const w : { 2, 4, 6, 8 } )
+        {
+            im::fixed_base_pow<T> const table{ g, w };
+
+            report("fixed_base_pow, w = " + std::to_string(w) + ":     " + name, ns_per_op([&]
+            {
+                im::s64 acc{ 0 };
+                for( auto const e : exponents )
+                {
+                    acc += table.pow(e).value();
+                }
+                sink = sink + acc;
+            }, count));
+        }
+    }
+
+    /** \fn auto bench_multi_pow() -> void
+        \brief Compares separate pow() calls, Straus, Pippenger and multi_pow() for k = 2, 4, ..., 4096 bases.
+                Times are per base.
+     */
+    auto bench_multi_pow() -> void
+    {
+        using T = im::montgomery_int_mod<2305843009213693951>;
+
+        for( std::size_t k{ 2 }; k <= 4096; k *= 2 )
+        {
+            auto const raw_bases = random_residues(2305843009213693951, k);
+            auto const exponents = random_residues(2305843009213693951, k);
+            std::vector<T> const bases(raw_bases.begin(), raw_bases.end());
+            std::size_t const reps{ std::max<std::size_t>(16, 262144 / k) };
+            std::string const suffix{ "k = " + std::to_string(k) };
+
+            report("multi_pow, separate pow(): " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    T acc{ 1 };
+                    for( std::size_t i{ 0 }; i < k; ++i )
+                    {
+                        acc *= bases[i].pow(exponents[i]);
+                    }
+                    sink = sink + acc.value();
+                }
+            }, reps * k));
+
+            report("multi_pow, Straus:         " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    sink = sink + im::multi_pow_straus(std::span{ bases }, exponents).value();
+                }
+            }, reps * k));
+
+            report("multi_pow, Pippenger:      " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    sink = sink + im::multi_pow_pippenger(std::span{ bases }, exponents).value();
+                }
+            }, reps * k));
+
+            report("multi_pow, auto:           " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    sink = sink + im::multi_pow(std::span{ bases }, exponents).value();
+                }
+            }, reps * k));
+        }
+    }
+
+    /** \fn auto bench_vector_kernels() -> void
+        \brief Compares vector_add/vector_mul/vector_fma at every supported simd_level.
+     */
+    template <im::s64 N>
+    auto bench_vector_kernels() -> void
+    {
+        using T = im::int_mod<N>;
+
+        constexpr std::size_t count{ 1 << 12 };
+        constexpr std::size_t reps{ 256 };
+        auto const raw_a = random_residues(N, count);
+        auto const raw_b = random_residues(N, count);
+        std::vector<T> const a(raw_a.begin(), raw_a.end());
+        std::vector<T> const b(raw_b.begin(), raw_b.end());
+        std::vector<T> out(count);
+
+        std::vector<std::pair<im::simd_level, std::string>> levels{ { im::simd_level::scalar, "scalar" } };
+
+        if( im::detected_simd_level() != im::simd_level::scalar )
+        {
+            levels.emplace_back(im::simd_level::avx2, "avx2");
+        }
+
+        if( im::detected_simd_level() == im::simd_level::avx512 )
+        {
+            levels.emplace_back(im::simd_level::avx512, "avx512");
+        }
+
+        for( auto const &[level, name] : levels )
+        {
+            std::string const suffix{ "int_mod<" + std::to_string(N) + ">, " + name };
+
+            report("vector_add: " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    im::vector_add(a, b, std::span{ out }, level);
+                    sink = sink + out[r].value();
+                }
+            }, reps * count));
+
+            report("vector_mul: " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    im::vector_mul(a, b, std::span{ out }, level);
+                    sink = sink + out[r].value();
+                }
+            }, reps * count));
+
+            report("vector_fma: " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    im::vector_fma(a, b, out, std::span{ out }, level);
+                    sink = sink + out[r].value();
+                }
+            }, reps * count));
+        }
+    }
+
+    /** \fn auto bench_ntt() -> void
+        \brief Times a forward plus inverse ntt_plan round trip, per point.
+     */
+    template <im::s64 N>
+    auto bench_ntt() -> void
+    {
+        using T = im::int_mod<N>;
+
+        for( int log_size : { 10, 16, 20 } )
+        {
+            std::size_t const size{ std::size_t{ 1 } << log_size };
+            std::size_t const reps{ std::max<std::size_t>(4, (std::size_t{ 1 } << 22) / size) };
+            auto const raw = random_residues(N, size);
+            std::vector<T> values(raw.begin(), raw.end());
+            im::ntt_plan<N> const plan{ size };
+
+            report("ntt_plan<" + std::to_string(N) + "> round trip: 2^" + std::to_string(log_size), ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    plan.forward(std::span{ values });
+                    plan.inverse(std::span{ values });
+                }
+                sink = sink + values[0].value();
+            }, reps * size));
+        }
+    }
+
+    /** \fn auto bench_polynomial() -> void
+        \brief Times each polynomial multiplication algorithm, and tree-based against naive multipoint evaluation,
+               to locate the thresholds in polynomial<T>.
+     */
+    template <im::s64 N>
+    auto bench_polynomial() -> void
+    {
+        using T = im::int_mod<N>;
+        using P = im::polynomial<T>;
+
+        std::string const name{ "int_mod<" + std::to_string(N) + ">" };
+
+        for( std::size_t size : { 16, 32, 64, 128, 256, 512, 1024, 4096, 16384 } )
+        {
+            auto const raw_a = random_residues(N, size);
+            auto const raw_b = random_residues(N, size);
+            std::vector<T> const a(raw_a.begin(), raw_a.end());
+            std::vector<T> const b(raw_b.begin(), raw_b.end());
+            std::size_t const reps{ std::max<std::size_t>(2, (std::size_t{ 1 } << 22) / (size * size)) };
+            std::string const suffix{ name + ", " + std::to_string(size) + " x " + std::to_string(size) };
+
+            report("polynomial schoolbook: " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    sink = sink + im::impl_details::multiply_schoolbook(std::span<T const>{ a }, std::span<T const>{ b })[size].value();
+                }
+            }, reps));
+
+            report("polynomial karatsuba:  " + suffix, ns_per_op([&]
+            {
+                for( std::size_t r{ 0 }; r < reps; ++r )
+                {
+                    sink = sink + im::impl_details::multiply_karatsuba<T>(a, b, P::karatsuba_threshold)[size].value();
+                }
+            }, reps));
+
+            if constexpr( im::impl_details::ntt_friendly<N>() )
+            {
+                report("polynomial ntt:        " + suffix, ns_per_op([&]
+                {
+                    for( std::size_t r{ 0 }; r < reps; ++r )
+                    {
+                        sink = sink + im::impl_details::multiply_ntt<N, im::remainder_reduction>(a, b)[size].value();
+                    }
+                }, reps));
+            }
+            else if constexpr( im::impl_details::three_prime_max_terms<N>() > 0 )
+            {
+                report("polynomial 3 primes:   " + suffix, ns_per_op([&]
+                {
+                    for( std::size_t r{ 0 }; r < reps; ++r )
+                    {
+                        sink = sink + im::impl_details::multiply_three_primes<N, im::remainder_reduction>(a, b, std::thread::hardware_concurrency() >= 3)[size].value();
+                    }
+                }, reps));
+            }
+        }
+
+        for( std::size_t size : { 64, 128, 256, 1024, 4096 } )
+        {
+            auto const raw = random_residues(N, size);
+            std::vector<T> const points(raw.begin(), raw.end());
+            P const p{ points };
+            std::string const suffix{ name + ", " + std::to_string(size) + " pts" };
+
+            report("multipoint Horner:     " + suffix, ns_per_op([&]
+            {
+                for( auto const x : points )
+                {
+                    sink = sink + p(x).value();
+                }
+            }, 1));
+
+            report("multipoint subproduct: " + suffix, ns_per_op([&]
+            {
+                sink = sink + im::impl_details::subproduct_tree<T>{ points }.evaluate(p, points)[0].value();
+            }, 1));
+        }
+    }
+
+    /** \fn auto bench_matrix() -> void
+        \brief Compares matrix<T>::multiply, which switches to Strassen-Winograd at strassen_cutoff, against the
+               blocked kernel alone and a naive i-k-j loop over int_mod<N>, per multiply-add.
+     */
+    template <im::s64 N>
+    auto bench_matrix() -> void
+    {
+        using T = im::int_mod<N>;
+        using M = im::matrix<T>;
+
+        for( std::size_t size : { 64, 256, 512, 1024 } )
+        {
+            auto const raw_a = random_residues(N, size * size);
+            auto const raw_b = random_residues(N, size * size);
+            M a(size, size), b(size, size);
+            std::copy(raw_a.begin(), raw_a.end(), a.data());
+            std::copy(raw_b.begin(), raw_b.end(), b.data());
+
+            std::string const suffix{ "int_mod<" + std::to_string(N) + ">, " + std::to_string(size) };
+            std::size_t const ops{ size * size * size };
+
+            report("matrix naive:    " + suffix, ns_per_op([&]
+            {
+                M c(size, size);
+
+                for( std::size_t i{ 0 }; i < size; ++i )
+                {
+                    for( std::size_t p{ 0 }; p < size; ++p )
+                    {
+                        for( std::size_t j{ 0 }; j < size; ++j )
+                        {
+                            c(i, j) += a(i, p) * b(p, j);
+                        }
+                    }
+                }
+
+                sink = sink + c(0, 0).value();
+            }, ops));
+
+            report("matrix blocked:  " + suffix, ns_per_op([&]
+            {
+                M c(size, size);
+                im::impl_details::gemm(a.data(), size, b.data(), size, c.data(), size, size, size, size,
+                                       im::impl_details::gemm_mode::assign, 1);
+                sink = sink + c(0, 0).value();
+            }, ops));
+
+            report("matrix multiply: " + suffix, ns_per_op([&]
+            {
+                sink = sink + M::multiply(a, b, 1)(0, 0).value();
+            }, ops));
+
+            if( std::thread::hardware_concurrency() > 1 )
+            {
+                report("matrix threads:  " + suffix, ns_per_op([&]
+                {
+                    sink = sink + M::multiply(a, b, std::thread::hardware_concurrency())(0, 0).value();
+                }, ops));
+            }
+        }
+    }
+
+    /** \fn auto bench_elimination() -> void
+        \brief Compares matrix<T>::determinant and inverse against unblocked Gaussian elimination, per n^3.
+     */
+    template <im::s64 N>
+    auto bench_elimination() -> void
+    {
+        using T = im::int_mod<N>;
+        using M = im::matrix<T>;
+
+        for( std::size_t size : { 128, 256, 512 } )
+        {
+            auto const raw = random_residues(N, size * size);
+            M a(size, size);
+            std::copy(raw.begin(), raw.end(), a.data());
+
+            std::string const suffix{ "int_mod<" + std::to_string(N) + ">, " + std::to_string(size) };
+            std::size_t const ops{ size * size * size };
+
+            report("determinant naive:   " + suffix, ns_per_op([&]
+            {
+                M c{ a };
+                T det{ 1 };
+
+                for( std::size_t k{ 0 }; k < size; ++k )
+                {
+                    std::size_t p{ k };
+
+                    while( p < size && c(p, k) == 0 )
+                    {
+                        ++p;
+                    }
+
+                    if( p == size )
+                    {
+                        det = 0;
+                        break;
+                    }
+
+                    if( p != k )
+                    {
+                        std::swap_ranges(c.row(p).begin(), c.row(p).end(), c.row(k).begin());
+                        det = -det;
+                    }
+
+                    det *= c(k, k);
+                    T const inverse{ c(k, k).inverse() };
+
+                    for( std::size_t i{ k + 1 }; i < size; ++i )
+                    {
+                        T const f{ c(i, k) * inverse };
+
+                        for( std::size_t j{ k }; j < size; ++j )
+                        {
+                            c(i, j) -= f * c(k, j);
+                        }
+                    }
+                }
+
+                sink = sink + det.value();
+            }, ops));
+
+            report("determinant blocked: " + suffix, ns_per_op([&]
+            {
+                sink = sink + a.determinant(1).value();
+            }, ops));
+
+            report("inverse blocked:     " + suffix, ns_per_op([&]
+            {
+                sink = sink + a.inverse(1)(0, 0).value();
+            }, ops));
+        }
+    }
+
+} // namespace
+
+int main()
+{
+    bench_inverse<97, 96>();
+    bench_inverse<1337, 1140>();
+    bench_inverse<998244353, 998244352>();
+    bench_inverse<1000000000, 400000000>();
+    bench_inverse<2305843009213693951, 2305843009213693950>();
+
+    bench_prime_inverse<97>();
+    bench_prime_inverse<998244353>();
+    bench_prime_inverse<2305843009213693951>();
+
+    bench_batch_inverse<998244353>();
+    bench_batch_inverse<2305843009213693951>();
+
+    bench_sqrt<1000000007>();
+    bench_sqrt<998244353>();
+    bench_sqrt<2305843009213693951>();
+
+    bench_jacobi<998244353>();
+    bench_jacobi<2147483647>();
+    bench_jacobi<2305843009213693951>();
+
+    bench_discrete_log<1000000007>(5, 256);
+    bench_discrete_log<1000000000000000003>(2, 16);
+
+    bench_dot<97>();
+    bench_dot<998244353>();
+    bench_dot<2305843009213693951>();
+
+    bench_shoup<998244353>();
+    bench_shoup<4294967291>();
+    bench_shoup<2305843009213693951>();
+
+    bench_rns();
+
+    bench_fixed_base_pow<im::int_mod<998244353>>("int_mod<998244353>");
+    bench_fixed_base_pow<im::montgomery_int_mod<2305843009213693951>>("montgomery_int_mod<2^61 - 1>");
+
+    bench_multi_pow();
+
+    bench_vector_kernels<998244353>();
+    bench_vector_kernels<2305843009213693951>();
+
+    bench_ntt<998244353>();
+    bench_ntt<4179340454199820289>();
+
+    bench_polynomial<998244353>();
+    bench_polynomial<1000000007>();
+
+    bench_matrix<97>();
+    bench_matrix<998244353>();
+    bench_matrix<2305843009213693951>();
+
+    bench_elimination<998244353>();
+    bench_elimination<2305843009213693951>();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,542 @@
+#pragma once
+#ifndef MATH_NERD_DISCRETE_LOG_H
+#define MATH_NERD_DISCRETE_LOG_H
+
+/** \file discrete_log.h
+    \brief Discrete logarithms in the units modulo N: Pohlig-Hellman over the order of the base, with baby-step
+           giant-step or Pollard's rho in each subgroup of prime order.
+ */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+#include "modulus_traits.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        namespace impl_details
+        {
+            /** \class bsgs_table
+                \brief Open-addressing hash table from residues to baby-step indices, for baby-step giant-step.
+                \details Linear probing over a power-of-two array of 16-byte slots kept at most half full, so a lookup
+                         touches one or two cache lines. Residues are non-negative, so -1 marks an empty slot.
+             */
+            class bsgs_table
+            {
+            private:
+                /** \struct slot
+                    \brief A residue and its baby-step index.
+                 */
+                struct slot
+                {
+                    s64 key{ -1 };
+                    s64 step{ 0 };
+                };
+
+                /** \property std::vector<slot> slots_
+                    \brief The table, with a power-of-two size.
+                 */
+                std::vector<slot> slots_;
+
+                /** \property int shift_
+                    \brief 64 minus the base 2 logarithm of the table size, for Fibonacci hashing.
+                 */
+                int shift_;
+
+                /** \fn auto home(s64 const key) const noexcept -> std::size_t
+                    \brief Returns the first slot probed for key.
+                 */
+                auto home(s64 const key) const noexcept -> std::size_t
+                {
+                    return static_cast<std::size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15u) >> shift_);
+                }
+
+            public:
+                /** \fn explicit bsgs_table(std::size_t const entries)
+                    \brief Creates an empty table with room for entries keys.
+                 */
+                explicit bsgs_table(std::size_t const entries);
+
+                /** \fn auto insert(s64 const key, s64 const step) -> void
+                    \brief Maps key to step. The keys must be distinct.
+                 */
+                auto insert(s64 const key, s64 const step) -> void;
+
+                /** \fn auto find(s64 const key) const noexcept -> s64
+                    \brief Returns the step stored for key, or -1 if there is none.
+                 */
+                auto find(s64 const key) const noexcept -> s64;
+
+                /** \fn auto slots() const noexcept -> std::size_t
+                    \brief Returns the number of slots allocated.
+                 */
+                auto slots() const noexcept -> std::size_t
+                {
+                    return slots_.size();
+                }
+            };
+
+            /** \struct log_subgroup<T>
+                \brief Precomputed data for the subgroup of order \f$p^e\f$ of the group generated by the base.
+             */
+            template <typename T>
+            struct log_subgroup
+            {
+                /** \property s64 prime
+                    \brief The prime p.
+                 */
+                s64 prime;
+
+                /** \property int exponent
+                    \brief The exponent e.
+                 */
+                int exponent;
+
+                /** \property s64 cofactor
+                    \brief The order of the base divided by \f$p^e\f$.
+                 */
+                s64 cofactor;
+
+                /** \property T generator_inverse
+                    \brief The inverse of base^cofactor, which generates the subgroup of order \f$p^e\f$.
+                 */
+                T generator_inverse;
+
+                /** \property T gamma
+                    \brief An element of order p: base raised to the order divided by p.
+                 */
+                T gamma;
+
+                /** \property s64 baby_steps
+                    \brief Number of baby steps m stored in table, or 0 if logarithms to base gamma use Pollard's rho.
+                 */
+                s64 baby_steps;
+
+                /** \property T giant_step
+                    \brief \f$\gamma^{-m}\f$.
+                 */
+                T giant_step;
+
+                /** \property std::optional<bsgs_table> table
+                    \brief \f$\gamma^j \mapsto j\f$ for \f$0 \le j < m\f$, if baby-step giant-step is used.
+                 */
+                std::optional<bsgs_table> table;
+            };
+
+            /** \fn auto log_bsgs(log_subgroup<T> const &group, T const beta) -> std::optional<s64>
+                \brief Returns the logarithm of beta to base group.gamma with baby-step giant-step, or std::nullopt if
+                       beta is not a power of group.gamma.
+             */
+            template <typename T>
+            auto log_bsgs(log_subgroup<T> const &group, T const beta) -> std::optional<s64>;
+
+            /** \fn auto log_rho(log_subgroup<T> const &group, T const beta) -> std::optional<s64>
+                \brief Returns the logarithm of beta to base group.gamma with Pollard's rho, or std::nullopt if none
+                       was found.
+                \details Uses an r-adding walk with 16 multipliers \f$\gamma^{a_i}\beta^{b_i}\f$ and Brent's cycle
+                         detection, so memory use is constant. A collision \f$\gamma^{a}\beta^{b} = \gamma^{a'}\beta^{b'}\f$
+                         gives the logarithm as \f$(a' - a)/(b - b')\f$ modulo p. Each walk is cut off after
+                         \f$16\sqrt{p}\f$ steps, well beyond the expected \f$\sqrt{\pi p/2}\f$, and a few walks are tried.
+             */
+            template <typename T>
+            auto log_rho(log_subgroup<T> const &group, T const beta) -> std::optional<s64>;
+
+            /** \fn auto order_factors() -> std::vector<std::pair<s64, int>> const &
+                \brief Returns the factorisation of modulus_traits<N>::carmichael, the exponent of the units modulo N.
+                       Computed on first use and cached.
+             */
+            template <s64 N>
+            auto order_factors() -> std::vector<std::pair<s64, int>> const &;
+
+        } // namespace impl_details
+
+        /** \class discrete_log_solver<N, Reduction>
+            \brief Solves \f$g^x = h\f$ for a fixed unit g modulo N and many targets h.
+            \details The constructor finds the order n of g from the factorisation of Carmichael's lambda of N.
+                     solve() then applies Pohlig-Hellman: for each prime power \f$p^e \,\|\, n\f$ it finds x modulo
+                     \f$p^e\f$ one base p digit at a time, each digit being a logarithm in a subgroup of order p, and
+                     combines the results by the Chinese remainder theorem. Each digit costs \f$O(\sqrt{p})\f$ operations:
+                     - baby-step giant-step with a table of \f$\lceil\sqrt{p}\rceil\f$ entries built by the constructor,
+                       for as many primes, smallest first, as fit in max_table_entries;
+                     - Pollard's rho, in constant memory, for the remaining primes. Primes below \f$2^{10}\f$ always get a
+                       table, as rho needs a large group.
+                     A table entry takes between 32 and 64 bytes, since the table is kept at most half full.
+         */
+        template <s64 N, typename Reduction = remainder_reduction>
+        class discrete_log_solver
+        {
+        private:
+            /** \property int_mod<N> base_
+                \brief The base g.
+             */
+            int_mod<N, Reduction> base_;
+
+            /** \property s64 order_
+                \brief The multiplicative order n of the base.
+             */
+            s64 order_;
+
+            /** \property std::vector<impl_details::log_subgroup<int_mod<N>>> subgroups_
+                \brief One entry per prime dividing the order, in increasing order of prime.
+             */
+            std::vector<impl_details::log_subgroup<int_mod<N, Reduction>>> subgroups_;
+
+        public:
+            /** \fn explicit discrete_log_solver(int_mod<N> const base, std::size_t const max_table_entries = std::size_t{ 1 } << 20)
+                \brief Precomputes the subgroups of the group generated by base. Throws std::invalid_argument if base is
+                       not a unit modulo N.
+             */
+            explicit discrete_log_solver(int_mod<N, Reduction> const base, std::size_t const max_table_entries = std::size_t{ 1 } << 20);
+
+            /** \fn auto base() const noexcept -> int_mod<N>
+                \brief Returns the base g.
+             */
+            auto base() const noexcept -> int_mod<N, Reduction>
+            {
+                return base_;
+            }
+
+            /** \fn auto order() const noexcept -> s64
+                \brief Returns the multiplicative order of the base.
+             */
+            auto order() const noexcept -> s64
+            {
+                return order_;
+            }
+
+            /** \fn auto table_entries() const noexcept -> std::size_t
+                \brief Returns the number of baby steps stored across all tables.
+             */
+            auto table_entries() const noexcept -> std::size_t;
+
+            /** \fn auto solve(int_mod<N> const h) const -> std::optional<s64>
+                \brief Returns the least \f$x \ge 0\f$ with \f$g^x = h\f$, or std::nullopt if h is not a power of g.
+             */
+            auto solve(int_mod<N, Reduction> const h) const -> std::optional<s64>;
+        };
+
+        /** \fn auto discrete_log(int_mod<N> const base, int_mod<N> const h, std::size_t const max_table_entries = std::size_t{ 1 } << 20) -> std::optional<s64>
+            \brief Returns the least \f$x \ge 0\f$ with \f$base^x = h\f$, or std::nullopt if there is none.
+                   Throws std::invalid_argument if base is not a unit modulo N.
+            \details Builds a discrete_log_solver, so when solving for many h with the same base, keep a solver instead.
+         */
+        template <s64 N, typename Reduction>
+        auto discrete_log(int_mod<N, Reduction> const base, int_mod<N, Reduction> const h,
+                          std::size_t const max_table_entries = std::size_t{ 1 } << 20) -> std::optional<s64>
+        {
+            return discrete_log_solver<N, Reduction>{ base, max_table_entries }.solve(h);
+        }
+
+        // Implementation function definitions.
+        namespace impl_details
+        {
+            inline bsgs_table::bsgs_table(std::size_t const entries)
+                : slots_(std::bit_ceil(2 * entries + 2)), shift_{ 64 - std::countr_zero(slots_.size()) }
+            {
+            }
+
+            inline auto bsgs_table::insert(s64 const key, s64 const step) -> void
+            {
+                std::size_t const mask{ slots_.size() - 1 };
+                std::size_t i{ home(key) };
+
+                while( slots_[i].key != -1 )
+                {
+                    i = (i + 1) & mask;
+                }
+
+                slots_[i] = slot{ key, step };
+            }
+
+            inline auto bsgs_table::find(s64 const key) const noexcept -> s64
+            {
+                std::size_t const mask{ slots_.size() - 1 };
+
+                for( std::size_t i{ home(key) }; slots_[i].key != -1; i = (i + 1) & mask )
+                {
+                    if( slots_[i].key == key )
+                    {
+                        return slots_[i].step;
+                    }
+                }
+
+                return -1;
+            }
+
+            template <typename T>
+            auto log_bsgs(log_subgroup<T> const &group, T const beta) -> std::optional<s64>
+            {
+                s64 const m{ group.baby_steps };
+                T giant{ beta };
+
+                // beta * gamma^(-m i) = gamma^j gives beta = gamma^(m i + j), and m i + j < p needs i <= p / m.
+                for( s64 i{ 0 }; i <= group.prime / m; ++i )
+                {
+                    if( s64 const j{ group.table->find(giant.value()) }; j != -1 )
+                    {
+                        return m * i + j;
+                    }
+
+                    giant *= group.giant_step;
+                }
+
+                return std::nullopt;
+            }
+
+            template <typename T>
+            auto log_rho(log_subgroup<T> const &group, T const beta) -> std::optional<s64>
+            {
+                constexpr int walks{ 4 };
+                constexpr std::size_t partitions{ 16 };
+
+                auto const p = static_cast<u64>(group.prime);
+                auto const limit = static_cast<u64>(16.0 * std::sqrt(static_cast<double>(p)));
+                u64 seed{ 0x9E3779B97F4A7C15u };
+
+                // SplitMix64, to pick exponents in [0, p).
+                auto const random_exponent = [&seed, p]
+                {
+                    u64 z{ seed += 0x9E3779B97F4A7C15u };
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+                    return (z ^ (z >> 31)) % p;
+                };
+
+                auto const add_mod = [p](u64 const x, u64 const y) { return x >= p - y ? x - (p - y) : x + y; };
+
+                for( int walk{ 0 }; walk < walks; ++walk )
+                {
+                    std::array<T, partitions> multipliers;
+                    std::array<u64, partitions> gamma_steps;
+                    std::array<u64, partitions> beta_steps;
+
+                    for( std::size_t i{ 0 }; i < partitions; ++i )
+                    {
+                        gamma_steps[i] = random_exponent();
+                        beta_steps[i] = random_exponent();
+                        multipliers[i] = group.gamma.pow(static_cast<s64>(gamma_steps[i])) * beta.pow(static_cast<s64>(beta_steps[i]));
+                    }
+
+                    // Invariant: x = gamma^a beta^b.
+                    u64 a{ random_exponent() };
+                    u64 b{ 1 };
+                    T x{ group.gamma.pow(static_cast<s64>(a)) * beta };
+
+                    T saved_x{ x };
+                    u64 saved_a{ a };
+                    u64 saved_b{ b };
+
+                    for( u64 step{ 1 }, power{ 1 }; step <= limit; ++step )
+                    {
+                        std::size_t const i{ static_cast<std::size_t>((static_cast<u64>(x.value()) * 0x9E3779B97F4A7C15u) >> 60) };
+
+                        x *= multipliers[i];
+                        a = add_mod(a, gamma_steps[i]);
+                        b = add_mod(b, beta_steps[i]);
+
+                        if( x == saved_x )
+                        {   // gamma^a beta^b = gamma^a' beta^b', so log(beta) (b - b') = a' - a.
+                            if( b != saved_b )
+                            {
+                                auto const inverse = static_cast<u64>(gcd_and_inverse(static_cast<s64>(add_mod(b, p - saved_b)), group.prime).second);
+                                auto const result = static_cast<s64>(mul_mod(add_mod(saved_a, p - a), inverse, p));
+
+                                if( group.gamma.pow(result) == beta )
+                                {
+                                    return result;
+                                }
+                            }
+
+                            break;
+                        }
+
+                        if( step == power )
+                        {   // Brent: compare against the element at each power of two.
+                            saved_x = x;
+                            saved_a = a;
+                            saved_b = b;
+                            power *= 2;
+                        }
+                    }
+                }
+
+                return std::nullopt;
+            }
+
+            template <s64 N>
+            auto order_factors() -> std::vector<std::pair<s64, int>> const &
+            {
+                static std::vector<std::pair<s64, int>> const factors{ factorize(modulus_traits<N>::carmichael) };
+
+                return factors;
+            }
+
+        } // namespace impl_details
+
+        template <s64 N, typename Reduction>
+        discrete_log_solver<N, Reduction>::discrete_log_solver(int_mod<N, Reduction> const base, std::size_t const max_table_entries)
+            : base_{ base }, order_{ modulus_traits<N>::carmichael }
+        {
+            using T = int_mod<N, Reduction>;
+
+            if( impl_details::gcd_and_inverse(base.value(), N).first != 1 )
+            {
+                throw std::invalid_argument("Base " + std::to_string(base.value()) + " of discrete_log_solver is not a unit modulo "
+                    + std::to_string(N) + ".\n");
+            }
+
+            // Reduce lambda(N) to the order of the base, one prime at a time.
+            std::vector<std::pair<s64, int>> factors;
+
+            for( auto [p, e] : impl_details::order_factors<N>() )
+            {
+                while( e > 0 && base_.pow(order_ / p) == 1 )
+                {
+                    order_ /= p;
+                    --e;
+                }
+
+                if( e > 0 )
+                {
+                    factors.emplace_back(p, e);
+                }
+            }
+
+            std::size_t budget{ max_table_entries };
+
+            for( auto const &[p, e] : factors )
+            {
+                s64 prime_power{ 1 };
+
+                for( int i{ 0 }; i < e; ++i )
+                {
+                    prime_power *= p;
+                }
+
+                impl_details::log_subgroup<T> group{ p, e, order_ / prime_power, T{ 1 }, base_.pow(order_ / p), 0, T{ 1 }, std::nullopt };
+                group.generator_inverse = base_.pow(group.cofactor).inverse();
+
+                // ceil(sqrt(p)) baby steps.
+                auto m = static_cast<s64>(std::sqrt(static_cast<double>(p)));
+
+                while( static_cast<u64>(m) * static_cast<u64>(m) < static_cast<u64>(p) )
+                {
+                    ++m;
+                }
+
+                while( static_cast<u64>(m - 1) * static_cast<u64>(m - 1) >= static_cast<u64>(p) )
+                {
+                    --m;
+                }
+
+                if( static_cast<std::size_t>(m) <= budget || p < (1 << 10) )
+                {
+                    budget -= std::min(budget, static_cast<std::size_t>(m));
+
+                    group.baby_steps = m;
+                    group.table.emplace(static_cast<std::size_t>(m));
+
+                    T power{ 1 };
+
+                    for( s64 j{ 0 }; j < m; ++j )
+                    {
+                        group.table->insert(power.value(), j);
+                        power *= group.gamma;
+                    }
+
+                    group.giant_step = power.inverse();
+                }
+
+                subgroups_.push_back(std::move(group));
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto discrete_log_solver<N, Reduction>::table_entries() const noexcept -> std::size_t
+        {
+            std::size_t total{ 0 };
+
+            for( auto const &group : subgroups_ )
+            {
+                total += static_cast<std::size_t>(group.baby_steps);
+            }
+
+            return total;
+        }
+
+        template <s64 N, typename Reduction>
+        auto discrete_log_solver<N, Reduction>::solve(int_mod<N, Reduction> const h) const -> std::optional<s64>
+        {
+            using T = int_mod<N, Reduction>;
+
+            if( h.pow(order_) != 1 )
+            {   // Every power of the base has order dividing order_.
+                return std::nullopt;
+            }
+
+            // x modulo the product of the prime powers handled so far.
+            u64 x{ 0 };
+            u64 modulus{ 1 };
+
+            for( auto const &group : subgroups_ )
+            {   // Find x modulo p^e in base p: with y = x mod p^k known, the next digit d satisfies
+                // gamma^d = (h_q g_q^-y)^(p^(e-1-k)), where g_q = g^cofactor and h_q = h^cofactor.
+                T const h_q{ h.pow(group.cofactor) };
+                s64 y{ 0 };
+                s64 digit_weight{ 1 };
+                s64 prime_power{ 1 };
+
+                for( int i{ 0 }; i < group.exponent; ++i )
+                {
+                    prime_power *= group.prime;
+                }
+
+                for( int k{ 0 }; k < group.exponent; ++k )
+                {
+                    prime_power /= group.prime;
+
+                    T const beta{ (h_q * group.generator_inverse.pow(y)).pow(prime_power) };
+                    std::optional<s64> const digit{ group.table ? impl_details::log_bsgs(group, beta) : impl_details::log_rho(group, beta) };
+
+                    if( !digit )
+                    {
+                        return std::nullopt;
+                    }
+
+                    y += *digit * digit_weight;
+                    digit_weight *= group.prime;
+                }
+
+                // Chinese remainder theorem: x + modulus t = y modulo p^e, where digit_weight is now p^e.
+                auto const q = static_cast<u64>(digit_weight);
+                u64 const inverse{ static_cast<u64>(impl_details::gcd_and_inverse(static_cast<s64>(modulus % q), digit_weight).second) };
+                u64 const t{ impl_details::mul_mod((static_cast<u64>(y) + q - x % q) % q, inverse, q) };
+
+                x += modulus * t;
+                modulus *= q;
+            }
+
+            return static_cast<s64>(x);
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -0,0 +1,737 @@
+#pragma once
+#ifndef MATH_NERD_DYNAMIC_INT_MOD_H
+#define MATH_NERD_DYNAMIC_INT_MOD_H
+
+/** \file dynamic_int_mod.h
+    \brief Runtime-modulus counterpart of int_mod<N>.
+ */
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+#include "modulus_traits.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \class modulus_context
+            \brief Runtime modulus shared by dynamic_int_mod values.
+            \details Everything which int_mod<N> derives from N at compile time (Barrett reciprocal, factorisation, phi)
+                     is computed once at construction, so per-operation cost is close to that of int_mod<N, barrett_reduction>.
+                     A context must outlive every dynamic_int_mod which refers to it.
+         */
+        class modulus_context
+        {
+        private:
+            /** \property s64 modulus_
+                \brief The modulus.
+             */
+            s64 modulus_;
+
+            /** \property bool narrow_
+                \brief True if the product of any two residues fits in a signed 64-bit integer.
+             */
+            bool narrow_;
+
+            /** \property u64 barrett64_
+                \brief Barrett reciprocal for 64-bit products.
+             */
+            u64 barrett64_;
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            /** \property u128 barrett128_
+                \brief Barrett reciprocal for 128-bit products.
+             */
+            u128 barrett128_;
+#endif
+
+            /** \property std::vector<std::pair<s64, int>> factors_
+                \brief Prime factorisation of the modulus.
+             */
+            std::vector<std::pair<s64, int>> factors_;
+
+            /** \property s64 phi_
+                \brief Euler phi of the modulus.
+             */
+            s64 phi_;
+
+        public:
+            /** \fn explicit modulus_context(s64 n)
+                \brief Precomputes the reducer for modulus n. Throws std::invalid_argument if n < 2.
+             */
+            explicit modulus_context(s64 n);
+
+            /** \fn auto modulus() const noexcept -> s64
+                \brief Returns the modulus.
+             */
+            auto modulus() const noexcept -> s64
+            {
+                return modulus_;
+            }
+
+            /** \fn auto phi() const noexcept -> s64
+                \brief Returns the Euler phi of the modulus.
+             */
+            auto phi() const noexcept -> s64
+            {
+                return phi_;
+            }
+
+            /** \fn auto factors() const noexcept -> std::vector<std::pair<s64, int>> const &
+                \brief Returns the prime factorisation of the modulus as (prime, exponent) pairs.
+             */
+            auto factors() const noexcept -> std::vector<std::pair<s64, int>> const &
+            {
+                return factors_;
+            }
+
+            /** \fn auto is_prime() const noexcept -> bool
+                \brief Returns true if the modulus is prime.
+             */
+            auto is_prime() const noexcept -> bool
+            {
+                return factors_.size() == 1 && factors_.front().second == 1;
+            }
+
+            /** \fn auto standard_modulo(s64 rhs) const noexcept -> s64
+                \brief Returns the standard form of rhs modulo the modulus.
+             */
+            auto standard_modulo(s64 rhs) const noexcept -> s64;
+
+            /** \fn auto mul(s64 const a, s64 const b) const noexcept -> s64
+                \brief Computes a * b modulo the modulus for a and b in standard form using Barrett reduction.
+             */
+            auto mul(s64 const a, s64 const b) const noexcept -> s64;
+
+            /** \fn auto inverse_of(s64 const n) const -> s64
+                \brief Computes the inverse of n modulo the modulus. Throws std::invalid_argument if not invertible.
+             */
+            auto inverse_of(s64 const n) const -> s64;
+
+            /** \fn auto try_inverse_of(s64 const n) const noexcept -> std::optional<s64>
+                \brief Computes the inverse of n modulo the modulus, or returns std::nullopt if not invertible.
+             */
+            auto try_inverse_of(s64 const n) const noexcept -> std::optional<s64>;
+
+            /** \fn auto operator==(modulus_context const &rhs) const noexcept -> bool
+                \brief Returns true if both contexts have the same modulus.
+             */
+            auto operator==(modulus_context const &rhs) const noexcept -> bool
+            {
+                return modulus_ == rhs.modulus_;
+            }
+
+            /** \fn auto operator!=(modulus_context const &rhs) const noexcept -> bool
+                \brief Returns false if both contexts have the same modulus.
+             */
+            auto operator!=(modulus_context const &rhs) const noexcept -> bool
+            {
+                return modulus_ != rhs.modulus_;
+            }
+        };
+
+        /** \class dynamic_int_mod
+            \brief Wrapper for 64-bit integer for arithmetic modulo a modulus chosen at runtime.
+            \details Mirrors the operator set of int_mod<N>. Both operands of a binary operation must refer to contexts
+                     with the same modulus; the result refers to the context of the left operand.
+         */
+        class dynamic_int_mod
+        {
+        private:
+            /** \property modulus_context const *context_
+                \brief The shared modulus context. Null for default constructed values.
+             */
+            modulus_context const *context_{ nullptr };
+
+            /** \property s64 element_
+                \brief The integer which will be taken modulo the modulus. Default initializes to 0.
+             */
+            s64 element_{ 0 };
+
+        public:
+            /** \fn dynamic_int_mod()
+                \brief Constructs a value without a context. It must be assigned from a dynamic_int_mod before use.
+             */
+            dynamic_int_mod() = default;
+
+            dynamic_int_mod(modulus_context const &context, s64 num) noexcept
+                : context_{ &context }, element_{ context.standard_modulo(num) }
+            {
+            }
+
+            /** \fn auto context() const noexcept -> modulus_context const &
+                \brief Returns the shared modulus context.
+             */
+            auto context() const noexcept -> modulus_context const &
+            {
+                return *context_;
+            }
+
+            /** \fn auto modulus() const noexcept -> s64
+                \brief Returns the modulus.
+             */
+            auto modulus() const noexcept -> s64
+            {
+                return context_->modulus();
+            }
+
+            /** \fn auto value() const noexcept -> s64
+                \brief Returns the stored value.
+             */
+            auto value() const noexcept -> s64
+            {
+                return element_;
+            }
+
+            /** \fn auto inverse() const -> s64
+                \brief Returns the inverse of the stored value. Throws std::invalid_argument if not invertible.
+             */
+            auto inverse() const -> s64
+            {
+                return context_->inverse_of(element_);
+            }
+
+            /** \fn auto pow(s64 const exponent) const -> dynamic_int_mod
+                \brief Returns the stored value raised to exponent. Throws std::invalid_argument if exponent is negative.
+             */
+            auto pow(s64 const exponent) const -> dynamic_int_mod
+            {
+                if( exponent < 0 )
+                {
+                    throw std::invalid_argument{ "Exponent must be non-negative." };
+                }
+
+                return impl_details::pow_binary(*this, dynamic_int_mod{ *context_, 1 }, static_cast<u64>(exponent));
+            }
+
+            /** \fn auto try_inverse() const noexcept -> std::optional<dynamic_int_mod>
+                \brief Returns the inverse of the stored value, or std::nullopt if not invertible.
+             */
+            auto try_inverse() const noexcept -> std::optional<dynamic_int_mod>;
+
+            /** \fn auto checked_div(dynamic_int_mod const rhs) const noexcept -> std::optional<dynamic_int_mod>
+                \brief Returns *this divided by rhs, or std::nullopt if rhs is not invertible.
+             */
+            auto checked_div(dynamic_int_mod const rhs) const noexcept -> std::optional<dynamic_int_mod>;
+
+            /** \fn auto checked_div(s64 const rhs) const noexcept -> std::optional<dynamic_int_mod>
+                \brief Returns *this divided by rhs, or std::nullopt if rhs is not invertible.
+             */
+            auto checked_div(s64 const rhs) const noexcept -> std::optional<dynamic_int_mod>;
+
+            /** \fn explicit operator s64() const
+                \brief Explicit type conversion back to a signed 64-bit integer.
+             */
+            explicit operator s64() const
+            {
+                return element_;
+            }
+
+            /** \name Increment/Decrement operators */
+            /** \fn auto operator++() noexcept -> dynamic_int_mod &
+                \brief Pre-increments element_ and reduces modulo the modulus.
+             */
+            auto operator++() noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator++(int) noexcept -> dynamic_int_mod
+                \brief Post-increments element_ and reduces modulo the modulus.
+             */
+            auto operator++(int) noexcept -> dynamic_int_mod;
+
+            /** \fn auto operator--() noexcept -> dynamic_int_mod &
+                \brief Pre-decrements element_ and reduces modulo the modulus.
+             */
+            auto operator--() noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator--(int) noexcept -> dynamic_int_mod
+                \brief Post-decrements element_ and reduces modulo the modulus.
+             */
+            auto operator--(int) noexcept -> dynamic_int_mod;
+
+            /** \name Unary operators */
+            /** \fn auto operator+() const noexcept -> dynamic_int_mod
+                \brief Returns the *this.
+             */
+            auto operator+() const noexcept -> dynamic_int_mod;
+
+            /** \fn auto operator-() const noexcept -> dynamic_int_mod
+                \brief Returns the additive inverse.
+             */
+            auto operator-() const noexcept -> dynamic_int_mod;
+
+            /** \name Assignment operators */
+            /** \fn auto operator+=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+                \brief Adds rhs to element_ and reduces.
+             */
+            auto operator+=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator-=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+                \brief Subtracts rhs from element_ and reduces.
+             */
+            auto operator-=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator*=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+                \brief Multiplies rhs to element_ and reduces.
+             */
+            auto operator*=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator/=(dynamic_int_mod const rhs) -> dynamic_int_mod &
+                \brief Divides by rhs, if invertible. Throws std::invalid_argument if rhs is not invertible.
+             */
+            auto operator/=(dynamic_int_mod const rhs) -> dynamic_int_mod &;
+
+            /** \fn auto operator=(s64 rhs) noexcept -> dynamic_int_mod &
+                \brief Assigns rhs to element_ and reduces. The value must already have a context.
+             */
+            auto operator=(s64 rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator+=(s64 rhs) noexcept -> dynamic_int_mod &
+                \brief Adds rhs to element_ and reduces.
+             */
+            auto operator+=(s64 rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator-=(s64 rhs) noexcept -> dynamic_int_mod &
+                \brief Subtracts rhs from element_ and reduces.
+             */
+            auto operator-=(s64 rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator*=(s64 rhs) noexcept -> dynamic_int_mod &
+                \brief Multiplies rhs to element_ and reduces.
+             */
+            auto operator*=(s64 rhs) noexcept -> dynamic_int_mod &;
+
+            /** \fn auto operator/=(s64 rhs) -> dynamic_int_mod &
+                \brief Divides by rhs, if invertible. Throws std::invalid_argument if rhs is not invertible.
+             */
+            auto operator/=(s64 rhs) -> dynamic_int_mod &;
+
+            /** \name Comparison operators */
+            /** \fn auto operator==(dynamic_int_mod const rhs) const noexcept -> bool
+                \brief Compares the values and returns true if equal.
+             */
+            auto operator==(dynamic_int_mod const rhs) const noexcept -> bool
+            {
+                return element_ == rhs.element_;
+            }
+
+            /** \fn auto operator!=(dynamic_int_mod const rhs) const noexcept -> bool
+                \brief Compares the values and returns false if equal.
+             */
+            auto operator!=(dynamic_int_mod const rhs) const noexcept -> bool
+            {
+                return element_ != rhs.element_;
+            }
+
+            /** \fn auto operator==(s64 rhs) const noexcept -> bool
+                \brief Compares the values and returns true if equal.
+             */
+            auto operator==(s64 rhs) const noexcept -> bool
+            {
+                return element_ == context_->standard_modulo(rhs);
+            }
+
+            /** \fn auto operator!=(s64 rhs) const noexcept -> bool
+                \brief Compares the values and returns false if equal.
+             */
+            auto operator!=(s64 rhs) const noexcept -> bool
+            {
+                return element_ != context_->standard_modulo(rhs);
+            }
+        };
+
+        // modulus_context definitions.
+        inline modulus_context::modulus_context(s64 n)
+            : modulus_{ n }, narrow_{ false }, barrett64_{ 0 }, phi_{ 0 }
+        {
+            if( n < 2 )
+            {
+                throw std::invalid_argument("Modulus " + std::to_string(n) + " of modulus_context must be at least 2.\n");
+            }
+
+            narrow_ = n - 1 <= std::numeric_limits<s64>::max() / (n - 1);
+            barrett64_ = ~u64{ 0 } / static_cast<u64>(n);
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            barrett128_ = ~u128{ 0 } / static_cast<u128>(n);
+#endif
+
+            factors_ = impl_details::factorize(n);
+
+            phi_ = n;
+            for( auto const &[p, k] : factors_ )
+            {
+                phi_ -= phi_ / p;
+            }
+        }
+
+        inline auto modulus_context::standard_modulo(s64 rhs) const noexcept -> s64
+        {
+            u64 const n{ static_cast<u64>(modulus_) };
+            u64 const x{ rhs < 0 ? u64{ 0 } - static_cast<u64>(rhs) : static_cast<u64>(rhs) };
+            u64 res{ x - impl_details::mul_hi(x, barrett64_) * n };
+
+            if( res >= n )
+            {
+                res -= n;
+            }
+
+            if( rhs < 0 && res != 0 )
+            {
+                res = n - res;
+            }
+
+            return static_cast<s64>(res);
+        }
+
+        inline auto modulus_context::mul(s64 const a, s64 const b) const noexcept -> s64
+        {
+            if( narrow_ )
+            {
+                u64 const n{ static_cast<u64>(modulus_) };
+                u64 const x{ static_cast<u64>(a) * static_cast<u64>(b) };
+                u64 res{ x - impl_details::mul_hi(x, barrett64_) * n };
+
+                return static_cast<s64>(res >= n ? res - n : res);
+            }
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            u128 const n{ static_cast<u128>(modulus_) };
+            u128 const x{ static_cast<u128>(a) * static_cast<u128>(b) };
+            u128 res{ x - impl_details::mul_hi(x, barrett128_) * n };
+
+            return static_cast<s64>(res >= n ? res - n : res);
+#else
+            return static_cast<s64>(impl_details::mul_mod(static_cast<u64>(a), static_cast<u64>(b), static_cast<u64>(modulus_)));
+#endif
+        }
+
+        inline auto modulus_context::try_inverse_of(s64 const n) const noexcept -> std::optional<s64>
+        {
+            auto const [d, inv] = impl_details::gcd_and_inverse(standard_modulo(n), modulus_);
+
+            if( d != 1 )
+            {
+                return std::nullopt;
+            }
+
+            return inv;
+        }
+
+        inline auto modulus_context::inverse_of(s64 const n) const -> s64
+        {
+            if( auto const inv = try_inverse_of(n) )
+            {
+                return *inv;
+            }
+
+            impl_details::throw_not_invertible(n, modulus_);
+        }
+
+        // Non-throwing inversion and division
+        inline auto dynamic_int_mod::try_inverse() const noexcept -> std::optional<dynamic_int_mod>
+        {
+            if( auto const inv = context_->try_inverse_of(element_) )
+            {
+                return dynamic_int_mod{ *context_, *inv };
+            }
+
+            return std::nullopt;
+        }
+
+        inline auto dynamic_int_mod::checked_div(dynamic_int_mod const rhs) const noexcept -> std::optional<dynamic_int_mod>
+        {
+            if( auto const inv = rhs.try_inverse() )
+            {
+                dynamic_int_mod res{ *this };
+                res.element_ = context_->mul(element_, inv->element_);
+                return res;
+            }
+
+            return std::nullopt;
+        }
+
+        inline auto dynamic_int_mod::checked_div(s64 const rhs) const noexcept -> std::optional<dynamic_int_mod>
+        {
+            return checked_div(dynamic_int_mod{ *context_, rhs });
+        }
+
+        // Increment/Decrement Operators
+        inline auto dynamic_int_mod::operator++() noexcept -> dynamic_int_mod &
+        {
+            if( element_ == modulus() - 1 )
+            {
+                element_ = 0;
+            }
+            else
+            {
+                ++element_;
+            }
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator++(int) noexcept -> dynamic_int_mod
+        {
+            dynamic_int_mod tmp(*this);
+            operator++();
+            return tmp;
+        }
+
+        inline auto dynamic_int_mod::operator--() noexcept -> dynamic_int_mod &
+        {
+            if( element_ == 0 )
+            {
+                element_ = modulus() - 1;
+            }
+            else
+            {
+                --element_;
+            }
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator--(int) noexcept -> dynamic_int_mod
+        {
+            dynamic_int_mod tmp(*this);
+            operator--();
+            return tmp;
+        }
+
+        // Unary operators
+        inline auto dynamic_int_mod::operator+() const noexcept -> dynamic_int_mod
+        {
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator-() const noexcept -> dynamic_int_mod
+        {
+            dynamic_int_mod res{ *this };
+            res.element_ = element_ == 0 ? 0 : modulus() - element_;
+            return res;
+        }
+
+        // Assignment operators
+        // dynamic_int_mod versions
+        inline auto dynamic_int_mod::operator+=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+        {
+            element_ -= modulus() - rhs.element_;
+
+            if( element_ < 0 )
+            {
+                element_ += modulus();
+            }
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator-=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+        {
+            element_ -= rhs.element_;
+
+            if( element_ < 0 )
+            {
+                element_ += modulus();
+            }
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator*=(dynamic_int_mod const rhs) noexcept -> dynamic_int_mod &
+        {
+            element_ = context_->mul(element_, rhs.element_);
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator/=(dynamic_int_mod const rhs) -> dynamic_int_mod &
+        {
+            element_ = context_->mul(element_, rhs.inverse());
+
+            return *this;
+        }
+
+        // s64 versions
+        inline auto dynamic_int_mod::operator=(s64 rhs) noexcept -> dynamic_int_mod &
+        {
+            element_ = context_->standard_modulo(rhs);
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator+=(s64 rhs) noexcept -> dynamic_int_mod &
+        {
+            return *this += dynamic_int_mod{ *context_, rhs };
+        }
+
+        inline auto dynamic_int_mod::operator-=(s64 rhs) noexcept -> dynamic_int_mod &
+        {
+            return *this -= dynamic_int_mod{ *context_, rhs };
+        }
+
+        inline auto dynamic_int_mod::operator*=(s64 rhs) noexcept -> dynamic_int_mod &
+        {
+            element_ = context_->mul(element_, context_->standard_modulo(rhs));
+
+            return *this;
+        }
+
+        inline auto dynamic_int_mod::operator/=(s64 rhs) -> dynamic_int_mod &
+        {
+            rhs = context_->inverse_of(rhs);
+
+            element_ = context_->mul(element_, rhs);
+
+            return *this;
+        }
+
+        /** \name Arithmetic operators. */
+
+        // dynamic_int_mod versions
+        /** \fn inline auto operator+(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of adding two dynamic_int_mod.
+         */
+        inline auto operator+(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+        {
+            lhs += rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator-(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of subtracting two dynamic_int_mod.
+         */
+        inline auto operator-(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+        {
+            lhs -= rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator*(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of multiplying two dynamic_int_mod.
+         */
+        inline auto operator*(dynamic_int_mod lhs, dynamic_int_mod const rhs) noexcept -> dynamic_int_mod
+        {
+            lhs *= rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator/(dynamic_int_mod lhs, dynamic_int_mod const rhs) -> dynamic_int_mod
+            \brief Returns the result of dividing two dynamic_int_mod. Throws std::invalid_argument if rhs is not invertible.
+         */
+        inline auto operator/(dynamic_int_mod lhs, dynamic_int_mod const rhs) -> dynamic_int_mod
+        {
+            lhs /= rhs;
+
+            return lhs;
+        }
+
+        // Right-s64 versions
+        /** \fn inline auto operator+(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of adding dynamic_int_mod and s64.
+         */
+        inline auto operator+(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+        {
+            lhs += rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator-(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of subtracting dynamic_int_mod by s64.
+         */
+        inline auto operator-(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+        {
+            lhs -= rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator*(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of multiplying dynamic_int_mod by s64.
+         */
+        inline auto operator*(dynamic_int_mod lhs, s64 rhs) noexcept -> dynamic_int_mod
+        {
+            lhs *= rhs;
+            return lhs;
+        }
+
+        /** \fn inline auto operator/(dynamic_int_mod lhs, s64 rhs) -> dynamic_int_mod
+            \brief Returns the result of dividing dynamic_int_mod by s64. Throws std::invalid_argument if rhs is not invertible.
+         */
+        inline auto operator/(dynamic_int_mod lhs, s64 rhs) -> dynamic_int_mod
+        {
+            lhs /= rhs;
+
+            return lhs;
+        }
+
+        // Left-s64 versions
+        /** \fn inline auto operator+(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of adding s64 and dynamic_int_mod.
+         */
+        inline auto operator+(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+        {
+            rhs += lhs;
+            return rhs;
+        }
+
+        /** \fn inline auto operator-(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of subtracting s64 by dynamic_int_mod.
+         */
+        inline auto operator-(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+        {
+            return dynamic_int_mod{ rhs.context(), lhs } - rhs;
+        }
+
+        /** \fn inline auto operator*(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+            \brief Returns the result of multiplying s64 by dynamic_int_mod.
+         */
+        inline auto operator*(s64 const lhs, dynamic_int_mod rhs) noexcept -> dynamic_int_mod
+        {
+            rhs *= lhs;
+            return rhs;
+        }
+
+        /** \fn inline auto operator/(s64 const lhs, dynamic_int_mod rhs) -> dynamic_int_mod
+            \brief Returns the result of dividing s64 by dynamic_int_mod. Throws std::invalid_argument if rhs is not invertible.
+         */
+        inline auto operator/(s64 const lhs, dynamic_int_mod rhs) -> dynamic_int_mod
+        {
+            return dynamic_int_mod{ rhs.context(), rhs.inverse() } * lhs;
+        }
+
+        // I/O operators
+        /** \fn inline auto operator<<(std::ostream &os, dynamic_int_mod const &rhs) -> std::ostream &
+            \brief Outputs our number in standard form. Returns the ostream object for further output.
+         */
+        inline auto operator<<(std::ostream &os, dynamic_int_mod const &rhs) -> std::ostream &
+        {
+            os << rhs.value();
+            return os;
+        }
+
+        /** \fn inline auto operator>>(std::istream &is, dynamic_int_mod &rhs) -> std::istream &
+            \brief Inputs our number in standard form, keeping the context of rhs. Returns the istream object for further input.
+         */
+        inline auto operator>>(std::istream &is, dynamic_int_mod &rhs) -> std::istream &
+        {
+            s64 tmp;
+            is >> tmp;
+
+            rhs = tmp;
+
+            return is;
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
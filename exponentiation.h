@@ -0,0 +1,439 @@
+#pragma once
+#ifndef MATH_NERD_EXPONENTIATION_H
+#define MATH_NERD_EXPONENTIATION_H
+
+/** \file exponentiation.h
+    \brief Precomputation-based exponentiation over the modular integer types.
+ */
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "int_mod.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \class fixed_base_pow<T>
+            \brief Evaluates \f$g^e\f$ for a fixed base g and many different exponents e.
+            \details T is any modular integer type (int_mod<N, Reduction>, montgomery_int_mod<N>, dynamic_int_mod).
+                     For a window width w the constructor stores \f$g^{d\cdot 2^{wi}}\f$ for every window position i and
+                     digit \f$1 \le d < 2^w\f$, so evaluating \f$g^e\f$ takes at most \f$\lceil b/w \rceil\f$ multiplications
+                     and no squarings, where b is the number of exponent bits covered by the table.
+                     The table holds \f$\lceil b/w \rceil\left(2^w - 1\right)\f$ elements.
+         */
+        template <typename T>
+        class fixed_base_pow
+        {
+        private:
+            /** \property T base_
+                \brief The fixed base g.
+             */
+            T base_;
+
+            /** \property T one_
+                \brief The multiplicative identity, returned for a zero exponent.
+             */
+            T one_;
+
+            /** \property int window_bits_
+                \brief Window width w.
+             */
+            int window_bits_;
+
+            /** \property int exponent_bits_
+                \brief Number of exponent bits b covered by the table.
+             */
+            int exponent_bits_;
+
+            /** \property std::vector<T> table_
+                \brief table_[i * (2^w - 1) + d - 1] holds \f$g^{d\cdot 2^{wi}}\f$.
+             */
+            std::vector<T> table_;
+
+        public:
+            /** \fn fixed_base_pow(T const base, int const window_bits = 4, int const exponent_bits = 63)
+                \brief Precomputes the window table for base. Throws std::invalid_argument unless
+                       1 <= window_bits <= 16 and 1 <= exponent_bits <= 63.
+             */
+            explicit fixed_base_pow(T const base, int const window_bits = 4, int const exponent_bits = 63);
+
+            /** \fn auto base() const noexcept -> T
+                \brief Returns the fixed base.
+             */
+            auto base() const noexcept -> T
+            {
+                return base_;
+            }
+
+            /** \fn auto window_bits() const noexcept -> int
+                \brief Returns the window width.
+             */
+            auto window_bits() const noexcept -> int
+            {
+                return window_bits_;
+            }
+
+            /** \fn auto table_size() const noexcept -> std::size_t
+                \brief Returns the number of precomputed elements.
+             */
+            auto table_size() const noexcept -> std::size_t
+            {
+                return table_.size();
+            }
+
+            /** \fn auto pow(s64 const exponent) const -> T
+                \brief Returns the base raised to exponent. Throws std::invalid_argument if exponent is negative or
+                       does not fit in the number of exponent bits the table was built for.
+             */
+            auto pow(s64 const exponent) const -> T;
+        };
+
+        /** \fn auto multi_pow_straus(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+            \brief Computes \f$\prod_i g_i^{e_i}\f$ with Straus' interleaved fixed-window method.
+            \details T is any modular integer type, optionally const qualified. Every base gets a table of its first
+                     \f$2^w - 1\f$ powers and all bases share one chain of squarings. Best for a handful of bases. Throws std::invalid_argument if the spans differ in length,
+                     are empty, or an exponent is negative.
+         */
+        template <typename T>
+        auto multi_pow_straus(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>;
+
+        /** \fn auto multi_pow_pippenger(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+            \brief Computes \f$\prod_i g_i^{e_i}\f$ with Pippenger's bucket method.
+            \details For each c-bit window the bases are multiplied into one of \f$2^c - 1\f$ buckets by their digit and the
+                     buckets are combined with two running products, so no per-base tables are needed. Best for many
+                     bases. Throws std::invalid_argument under the same conditions as multi_pow_straus().
+         */
+        template <typename T>
+        auto multi_pow_pippenger(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>;
+
+        /** \fn auto multi_pow(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+            \brief Computes \f$\prod_i g_i^{e_i}\f$ sharing squarings across bases.
+            \details Picks Straus or Pippenger, and the window width for each, by minimising a multiplication count model
+                     of the two methods for the given number of bases and exponent length.
+         */
+        template <typename T>
+        auto multi_pow(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>;
+
+        namespace impl_details
+        {
+            /** \fn auto check_multi_pow_arguments(std::size_t const bases, std::span<s64 const> const exponents) -> int
+                \brief Validates the arguments of the multi_pow functions and returns the bit length of the largest exponent.
+             */
+            inline auto check_multi_pow_arguments(std::size_t const bases, std::span<s64 const> const exponents) -> int;
+
+            /** \fn constexpr auto straus_cost(std::size_t const k, int const bits, int const w) noexcept -> std::size_t
+                \brief Multiplications used by Straus with k bases, bits-bit exponents and window width w.
+             */
+            constexpr auto straus_cost(std::size_t const k, int const bits, int const w) noexcept -> std::size_t;
+
+            /** \fn constexpr auto pippenger_cost(std::size_t const k, int const bits, int const c) noexcept -> std::size_t
+                \brief Multiplications used by Pippenger with k bases, bits-bit exponents and window width c.
+             */
+            constexpr auto pippenger_cost(std::size_t const k, int const bits, int const c) noexcept -> std::size_t;
+
+            /** \fn constexpr auto best_window(Cost const cost, std::size_t const k, int const bits) noexcept -> int
+                \brief Returns the window width in [1, 16] minimising cost(k, bits, width).
+             */
+            template <typename Cost>
+            constexpr auto best_window(Cost const cost, std::size_t const k, int const bits) noexcept -> int;
+
+        } // namespace impl_details
+
+        template <typename T>
+        fixed_base_pow<T>::fixed_base_pow(T const base, int const window_bits, int const exponent_bits)
+            : base_{ base }, one_{ base.pow(0) }, window_bits_{ window_bits }, exponent_bits_{ exponent_bits }
+        {
+            if( window_bits < 1 || window_bits > 16 )
+            {
+                throw std::invalid_argument("Window width " + std::to_string(window_bits) + " of fixed_base_pow must be between 1 and 16.\n");
+            }
+
+            if( exponent_bits < 1 || exponent_bits > 63 )
+            {
+                throw std::invalid_argument("Exponent bits " + std::to_string(exponent_bits) + " of fixed_base_pow must be between 1 and 63.\n");
+            }
+
+            std::size_t const digits{ (std::size_t{ 1 } << window_bits) - 1 };
+            std::size_t const windows{ static_cast<std::size_t>((exponent_bits + window_bits - 1) / window_bits) };
+
+            table_.reserve(windows * digits);
+
+            T step{ base };  // g^(2^(w * i))
+
+            for( std::size_t i{ 0 }; i < windows; ++i )
+            {
+                table_.push_back(step);
+
+                for( std::size_t d{ 2 }; d <= digits; ++d )
+                {
+                    table_.push_back(table_.back() * step);
+                }
+
+                step = table_.back() * step;
+            }
+        }
+
+        template <typename T>
+        auto fixed_base_pow<T>::pow(s64 const exponent) const -> T
+        {
+            if( exponent < 0 )
+            {
+                throw std::invalid_argument{ "Exponent must be non-negative." };
+            }
+
+            if( exponent_bits_ < 63 && (exponent >> exponent_bits_) != 0 )
+            {
+                throw std::invalid_argument("Exponent " + std::to_string(exponent) + " does not fit in the "
+                    + std::to_string(exponent_bits_) + " bits of this fixed_base_pow table.\n");
+            }
+
+            u64 const mask{ (u64{ 1 } << window_bits_) - 1 };
+            u64 e{ static_cast<u64>(exponent) };
+            T res{ one_ };
+
+            for( std::size_t offset{ 0 }; e != 0; offset += mask, e >>= window_bits_ )
+            {
+                if( u64 const d{ e & mask }; d != 0 )
+                {
+                    res *= table_[offset + d - 1];
+                }
+            }
+
+            return res;
+        }
+
+        namespace impl_details
+        {
+            inline auto check_multi_pow_arguments(std::size_t const bases, std::span<s64 const> const exponents) -> int
+            {
+                if( bases != exponents.size() )
+                {
+                    throw std::invalid_argument("multi_pow was given " + std::to_string(bases) + " bases but "
+                        + std::to_string(exponents.size()) + " exponents.\n");
+                }
+
+                if( bases == 0 )
+                {
+                    throw std::invalid_argument{ "multi_pow requires at least one base." };
+                }
+
+                s64 largest{ 0 };
+
+                for( auto const e : exponents )
+                {
+                    if( e < 0 )
+                    {
+                        throw std::invalid_argument{ "Exponent must be non-negative." };
+                    }
+
+                    largest = std::max(largest, e);
+                }
+
+                return static_cast<int>(std::bit_width(static_cast<u64>(largest)));
+            }
+
+            constexpr auto straus_cost(std::size_t const k, int const bits, int const w) noexcept -> std::size_t
+            {
+                std::size_t const windows{ static_cast<std::size_t>((bits + w - 1) / w) };
+
+                return k * ((std::size_t{ 1 } << w) - 2) + static_cast<std::size_t>(bits) + k * windows;
+            }
+
+            constexpr auto pippenger_cost(std::size_t const k, int const bits, int const c) noexcept -> std::size_t
+            {
+                std::size_t const windows{ static_cast<std::size_t>((bits + c - 1) / c) };
+
+                return windows * (k + 2 * (std::size_t{ 1 } << c) + static_cast<std::size_t>(c));
+            }
+
+            template <typename Cost>
+            constexpr auto best_window(Cost const cost, std::size_t const k, int const bits) noexcept -> int
+            {
+                int best{ 1 };
+
+                for( auto w{ 2 }; w <= 16; ++w )
+                {
+                    if( cost(k, bits, w) < cost(k, bits, best) )
+                    {
+                        best = w;
+                    }
+                }
+
+                return best;
+            }
+
+        } // namespace impl_details
+
+        template <typename T>
+        auto multi_pow_straus(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+        {
+            int const bits{ impl_details::check_multi_pow_arguments(bases.size(), exponents) };
+            std::remove_cv_t<T> res{ bases.front().pow(0) };
+
+            if( bits == 0 )
+            {
+                return res;
+            }
+
+            int const w{ impl_details::best_window(impl_details::straus_cost, bases.size(), bits) };
+            std::size_t const digits{ (std::size_t{ 1 } << w) - 1 };
+
+            // table[i * digits + d - 1] = bases[i]^d
+            std::vector<std::remove_cv_t<T>> table;
+            table.reserve(bases.size() * digits);
+
+            for( auto const &g : bases )
+            {
+                table.push_back(g);
+
+                for( std::size_t d{ 2 }; d <= digits; ++d )
+                {
+                    table.push_back(table.back() * g);
+                }
+            }
+
+            u64 const mask{ digits };
+            int const top{ ((bits - 1) / w) * w };
+
+            for( auto shift{ top }; shift >= 0; shift -= w )
+            {
+                if( shift != top )
+                {   // The leading window needs no squarings: res is still the identity.
+                    for( auto i{ 0 }; i < w; ++i )
+                    {
+                        res *= res;
+                    }
+                }
+
+                for( std::size_t i{ 0 }; i < bases.size(); ++i )
+                {
+                    if( u64 const d{ (static_cast<u64>(exponents[i]) >> shift) & mask }; d != 0 )
+                    {
+                        res *= table[i * digits + d - 1];
+                    }
+                }
+            }
+
+            return res;
+        }
+
+        template <typename T>
+        auto multi_pow_pippenger(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+        {
+            int const bits{ impl_details::check_multi_pow_arguments(bases.size(), exponents) };
+            std::remove_cv_t<T> res{ bases.front().pow(0) };
+
+            if( bits == 0 )
+            {
+                return res;
+            }
+
+            int const c{ impl_details::best_window(impl_details::pippenger_cost, bases.size(), bits) };
+            std::size_t const digits{ (std::size_t{ 1 } << c) - 1 };
+            u64 const mask{ digits };
+
+            std::vector<std::remove_cv_t<T>> buckets(digits, res);
+            std::vector<bool> filled(digits);
+
+            int const top{ ((bits - 1) / c) * c };
+
+            for( auto shift{ top }; shift >= 0; shift -= c )
+            {
+                if( shift != top )
+                {
+                    for( auto i{ 0 }; i < c; ++i )
+                    {
+                        res *= res;
+                    }
+                }
+
+                std::fill(filled.begin(), filled.end(), false);
+
+                for( std::size_t i{ 0 }; i < bases.size(); ++i )
+                {
+                    if( u64 const d{ (static_cast<u64>(exponents[i]) >> shift) & mask }; d != 0 )
+                    {
+                        if( filled[d - 1] )
+                        {
+                            buckets[d - 1] *= bases[i];
+                        }
+                        else
+                        {
+                            buckets[d - 1] = bases[i];
+                            filled[d - 1] = true;
+                        }
+                    }
+                }
+
+                // window = prod_d bucket_d^d, as the product of the suffix products running over d = 2^c - 1, ..., 1.
+                bool started{ false };
+                std::remove_cv_t<T> running{ res };
+                std::remove_cv_t<T> window{ res };
+
+                for( auto d{ digits }; d > 0; --d )
+                {
+                    if( filled[d - 1] )
+                    {
+                        if( started )
+                        {
+                            running *= buckets[d - 1];
+                        }
+                        else
+                        {
+                            running = buckets[d - 1];
+                            window = buckets[d - 1];
+                            started = true;
+                            continue;
+                        }
+                    }
+
+                    if( started )
+                    {
+                        window *= running;
+                    }
+                }
+
+                if( started )
+                {
+                    res *= window;
+                }
+            }
+
+            return res;
+        }
+
+        template <typename T>
+        auto multi_pow(std::span<T> const bases, std::span<s64 const> const exponents) -> std::remove_cv_t<T>
+        {
+            int const bits{ impl_details::check_multi_pow_arguments(bases.size(), exponents) };
+            std::size_t const k{ bases.size() };
+
+            std::size_t const straus{ impl_details::straus_cost(k, bits, impl_details::best_window(impl_details::straus_cost, k, bits)) };
+            std::size_t const pippenger{ impl_details::pippenger_cost(k, bits, impl_details::best_window(impl_details::pippenger_cost, k, bits)) };
+
+            if( straus <= pippenger )
+            {
+                return multi_pow_straus(bases, exponents);
+            }
+
+            return multi_pow_pippenger(bases, exponents);
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
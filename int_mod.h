@@ -5,11 +5,21 @@
 /** \file int_mod.h
     \brief std::int64_t wrapper for arithmetic modulo N.
  */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <optional>
+#include <ranges>
 #include <stdexcept>
+#include <span>
 #include <sstream>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
  /** \namespace math_nerd
      \brief Namespace for all of my projects.
@@ -26,6 +36,68 @@ namespace math_nerd
          */
         using s64 = std::int64_t;
 
+        /** \name Unsigned 32-bit integer
+         */
+        using u32 = std::uint32_t;
+
+        /** \name Unsigned 64-bit integer
+         */
+        using u64 = std::uint64_t;
+
+#if defined(__SIZEOF_INT128__)
+        /** \def MATH_NERD_INT_MOD_HAS_INT128
+            \brief Defined when the compiler provides a native unsigned 128-bit integer.
+         */
+        #define MATH_NERD_INT_MOD_HAS_INT128
+
+        /** \name Unsigned 128-bit integer
+         */
+        __extension__ using u128 = unsigned __int128;
+#endif
+
+
+        /** \struct remainder_reduction
+            \brief Reduction policy which takes remainders with the hardware division instruction. Default for int_mod<N>.
+         */
+        struct remainder_reduction
+        {
+            /** \fn static constexpr auto reduce(u64 x) noexcept -> s64
+                \brief Returns x modulo N.
+             */
+            template <s64 N>
+            static constexpr auto reduce(u64 x) noexcept -> s64;
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            /** \fn static constexpr auto reduce(u128 x) noexcept -> s64
+                \brief Returns x modulo N.
+             */
+            template <s64 N>
+            static constexpr auto reduce(u128 x) noexcept -> s64;
+#endif
+        };
+
+        /** \struct barrett_reduction
+            \brief Reduction policy which replaces division by N with multiplication by a precomputed reciprocal.
+            \details With \f$m = \lfloor (2^k - 1)/N \rfloor\f$ computed at compile time, the quotient estimate
+                     \f$\lfloor xm/2^k \rfloor\f$ is never more than one below the true quotient, so a reduction costs
+                     two multiplications and a conditional subtraction. k is 64 for 64-bit inputs and 128 for 128-bit inputs.
+         */
+        struct barrett_reduction
+        {
+            /** \fn static constexpr auto reduce(u64 x) noexcept -> s64
+                \brief Returns x modulo N.
+             */
+            template <s64 N>
+            static constexpr auto reduce(u64 x) noexcept -> s64;
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            /** \fn static constexpr auto reduce(u128 x) noexcept -> s64
+                \brief Returns x modulo N.
+             */
+            template <s64 N>
+            static constexpr auto reduce(u128 x) noexcept -> s64;
+#endif
+        };
 
         /** \namespace math_nerd::int_mod::impl_details
             \brief Contains implementation details.
@@ -44,20 +116,123 @@ namespace math_nerd
              */
             constexpr auto euler_phi(s64 N) noexcept -> s64;
 
+            /** \fn constexpr auto fits_narrow() noexcept -> bool
+                \brief Returns true if the product of any two residues modulo N fits in a signed 64-bit integer.
+             */
+            template <s64 N>
+            constexpr auto fits_narrow() noexcept -> bool;
+
+            /** \fn constexpr auto mul_hi(u64 const a, u64 const b) noexcept -> u64
+                \brief Returns the upper 64 bits of the 128-bit product a * b.
+             */
+            constexpr auto mul_hi(u64 const a, u64 const b) noexcept -> u64;
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            /** \fn constexpr auto mul_hi(u128 const a, u128 const b) noexcept -> u128
+                \brief Returns the upper 128 bits of the 256-bit product a * b.
+             */
+            constexpr auto mul_hi(u128 const a, u128 const b) noexcept -> u128;
+#endif
+
+            /** \var barrett_factor<N, T>
+                \brief The Barrett reciprocal \f$\lfloor (2^k - 1)/N \rfloor\f$, where k is the bit width of T.
+             */
+            template <s64 N, typename T>
+            inline constexpr T barrett_factor{ static_cast<T>(~T{ 0 } / static_cast<T>(N)) };
+
+            /** \fn constexpr auto mul_mod(s64 const a, s64 const b) noexcept -> s64
+                \brief Computes a * b modulo N for a and b in standard form.
+                \details Selected at compile time: when (N - 1)^2 fits in s64 the product is formed in 64 bits,
+                         otherwise it is formed in 128 bits (or by a portable double-and-add loop when the compiler
+                         has no 128-bit integer type). The product is then reduced with the Reduction policy.
+             */
+            template <s64 N, typename Reduction = remainder_reduction>
+            constexpr auto mul_mod(s64 const a, s64 const b) noexcept -> s64;
+
+            /** \fn constexpr auto pow_binary(T const base, T const one, u64 const exponent) noexcept -> T
+                \brief Left-to-right binary exponentiation over any modular integer type T.
+                \details Walks the exponent from its leading bit down, squaring once per bit and multiplying by base for
+                         each set bit. one is the multiplicative identity of T, returned for a zero exponent.
+             */
+            template <typename T>
+            constexpr auto pow_binary(T const base, T const one, u64 const exponent) noexcept -> T;
+
+            /** \fn constexpr auto pow_unrolled(T const base, T const one) noexcept -> T
+                \brief Computes base to the power E with the square-and-multiply chain fully unrolled at compile time.
+             */
+            template <u64 E, typename T>
+            constexpr auto pow_unrolled(T const base, T const one) noexcept -> T;
+
             /** \fn constexpr auto ipow(s64 const base, s64 const exponent) -> s64
                 \brief Computes base to the power exponent modulo N.
-                \details This function uses a divide-and-conquer algorithm which takes advantage of integer division to
-                         divide the exponent in half at each level of recursion until an exponent of 0 is reached, for
-                         which it returns 1. It then multiplies the results together while taking remainders after division by N.
+                \details Iterative left-to-right binary exponentiation (see pow_binary()).
                          Throws std::invalid_argument if exponent is negative.
              */
             template<s64 N>
             constexpr auto ipow(s64 const base, s64 const exponent) -> s64;
 
+            /** \fn constexpr auto gcd_and_inverse(s64 const a, s64 const n) noexcept -> std::pair<s64, s64>
+                \brief Returns \f$\left(\gcd\left(a,n\right), a^{-1}\ \mathrm{mod}\ n\right)\f$ for \f$0 \le a < n\f$.
+                \details Iterative extended Euclidean algorithm which only tracks the Bezout coefficient of a. The inverse is
+                         only meaningful when the gcd is 1. Every coefficient is bounded by n in absolute value, so nothing
+                         overflows for any 64-bit n.
+             */
+            constexpr auto gcd_and_inverse(s64 const a, s64 const n) noexcept -> std::pair<s64, s64>;
+
+            /** \fn constexpr auto gcd_and_inverse_narrow(u32 const a, u32 const n) noexcept -> std::pair<s64, s64>
+                \brief gcd_and_inverse() for \f$n < 2^{32}\f$, whose 32-bit divisions are cheaper than 64-bit ones.
+             */
+            constexpr auto gcd_and_inverse_narrow(u32 const a, u32 const n) noexcept -> std::pair<s64, s64>;
+
+            /** \fn constexpr auto mul_mod(u64 const a, u64 const b, u64 const n) noexcept -> u64
+                \brief Computes a * b modulo a runtime modulus n for a and b in standard form.
+             */
+            constexpr auto mul_mod(u64 const a, u64 const b, u64 const n) noexcept -> u64;
+
+            /** \fn constexpr auto pow_mod(u64 base, u64 exponent, u64 const n) noexcept -> u64
+                \brief Computes base to the power exponent modulo a runtime modulus n.
+             */
+            constexpr auto pow_mod(u64 base, u64 exponent, u64 const n) noexcept -> u64;
+
+            /** \fn constexpr auto is_prime(u64 const n) noexcept -> bool
+                \brief Deterministic Miller-Rabin primality test, exact for all 64-bit integers.
+             */
+            constexpr auto is_prime(u64 const n) noexcept -> bool;
+
+            /** \var prime_modulus<N>
+                \brief True if N is prime, decided at compile time with is_prime().
+             */
+            template <s64 N>
+            inline constexpr bool prime_modulus{ is_prime(static_cast<u64>(N)) };
+
+            /** \fn constexpr auto prime_inverse_of(s64 const n) noexcept -> s64
+                \brief Computes the inverse of n in [1, N) for a prime N, which needs no gcd check.
+                \details The method is fixed at compile time from measured costs. Below \f$2^8\f$ it is Fermat's
+                         \f$n^{N-2}\f$, an unrolled chain of at most 14 multiplications with no branches. Above that, extended
+                         Euclid is faster, so it runs in 32-bit words when N fits them and 64-bit ones otherwise.
+             */
+            template <s64 N>
+            constexpr auto prime_inverse_of(s64 const n) noexcept -> s64;
+
+            /** \fn constexpr auto try_inverse_of(s64 const n) noexcept -> std::optional<s64>
+                \brief Computes the inverse of an integer modulo N, or returns std::nullopt if not invertible.
+                        Never throws or allocates.
+             */
+            template <s64 N>
+            constexpr auto try_inverse_of(s64 const n) noexcept -> std::optional<s64>;
+
+            /** \fn auto throw_not_invertible(s64 const n, s64 const modulus) -> void
+                \brief Throws the std::invalid_argument reported when n is not invertible modulo modulus.
+                \details Kept out of line so that building the message does not weigh down the inlined fast paths.
+             */
+            [[noreturn]] auto throw_not_invertible(s64 const n, s64 const modulus) -> void;
+
             /** \fn auto inverse_of(s64 const n) -> s64
                 \brief Computes the inverse of an integer modulo N. Throws std::invalid_argument if not invertible.
-                \brief By Euler's theorem, \f$a^{\phi\left(N\right)}\equiv 1\ \left(\mathrm{mod}\ N\right)\f$ for \f$\gcd\left(a,N\right)=1,\f$
-                       which implies that that \f$a^{\phi\left(N\right)-1}\equiv a^{-1}\ \left(\mathrm{mod}\ N\right)\f$ under the same condition.
+                \details The gcd check and the inverse come out of a single pass of gcd_and_inverse(), which needs
+                         \f$O\left(\log N\right)\f$ divisions of shrinking operands rather than the
+                         \f$O\left(\log N\right)\f$ modular multiplications of \f$a^{\phi\left(N\right)-1}\f$.
+                         For prime N the gcd check is dropped and prime_inverse_of() picks the cheaper method.
              */
             template <s64 N>
             constexpr auto inverse_of(s64 const n) -> s64;
@@ -66,19 +241,105 @@ namespace math_nerd
                 \brief Returns the standard form of rhs modulo N. The standard form is the integer
                        between 0 and N-1 (inclusive) which is equivalent to rhs modulo N.
              */
-            template <s64 N>
+            template <s64 N, typename Reduction = remainder_reduction>
             constexpr auto standard_modulo(s64 rhs) -> s64;
 
+            /** \fn constexpr auto jacobi_symbol(u64 a, u64 n) noexcept -> int
+                \brief Returns the Jacobi symbol \f$(a/n)\f$ for odd n, using only shifts, swaps and subtractions.
+             */
+            constexpr auto jacobi_symbol(u64 a, u64 n) noexcept -> int;
+
+            /** \fn constexpr auto least_non_residue(u64 const n) noexcept -> u64
+                \brief Returns the least quadratic non-residue modulo the odd prime n.
+             */
+            constexpr auto least_non_residue(u64 const n) noexcept -> u64;
+
+            /** \struct sqrt_traits<N>
+                \brief Compile-time constants for square roots modulo the odd prime N.
+                \details Every method starts from \f$w = a^E\f$ for the exponent below, so the only work that depends on
+                         a is one exponentiation followed by sqrt_finish().
+             */
+            template <s64 N>
+            struct sqrt_traits
+            {
+                /** \property static constexpr int two_adicity
+                    \brief s with \f$N - 1 = 2^s q\f$, q odd.
+                 */
+                static constexpr int two_adicity{ std::countr_zero(static_cast<u64>(N - 1)) };
+
+                /** \property static constexpr u64 odd_part
+                    \brief q with \f$N - 1 = 2^s q\f$, q odd.
+                 */
+                static constexpr u64 odd_part{ static_cast<u64>(N - 1) >> two_adicity };
+
+                /** \property static constexpr u64 exponent
+                    \brief \f$(N+1)/4\f$ if \f$N \equiv 3 \pmod 4\f$, \f$(N-5)/8\f$ if \f$N \equiv 5 \pmod 8\f$, otherwise \f$(q-1)/2\f$.
+                 */
+                static constexpr u64 exponent{ N % 4 == 3 ? static_cast<u64>(N + 1) / 4
+                                             : N % 8 == 5 ? static_cast<u64>(N - 5) / 8
+                                                          : (odd_part - 1) / 2 };
+
+                /** \property static constexpr s64 two_power
+                    \brief \f$2^E \bmod N\f$, which turns \f$a^E\f$ into Atkin's \f$(2a)^E\f$.
+                 */
+                static constexpr s64 two_power{ static_cast<s64>(pow_mod(2, exponent, static_cast<u64>(N))) };
+
+                /** \property static constexpr std::array<s64, 64> unity_powers
+                    \brief unity_powers[j] is \f$g^{2^j} \bmod N\f$ for j < s, where \f$g = z^q\f$ for the least non-residue z
+                            is a primitive \f$2^s\f$-th root of unity. Only filled for Tonelli-Shanks, when \f$N \equiv 1 \pmod 8\f$.
+                 */
+                static constexpr std::array<s64, 64> unity_powers{ []
+                {
+                    std::array<s64, 64> powers{ };
+
+                    if constexpr( N % 8 == 1 )
+                    {
+                        auto const n = static_cast<u64>(N);
+                        u64 g{ pow_mod(least_non_residue(n), odd_part, n) };
+
+                        for( int j{ 0 }; j < two_adicity; ++j )
+                        {
+                            powers[static_cast<std::size_t>(j)] = static_cast<s64>(g);
+                            g = mul_mod(g, g, n);
+                        }
+                    }
+
+                    return powers;
+                }() };
+            };
+
+            /** \struct lockstep<T, L>
+                \brief L values of T multiplied lane by lane, so that pow_unrolled() runs L independent chains side by side.
+             */
+            template <typename T, std::size_t L>
+            struct lockstep
+            {
+                /** \property std::array<T, L> lanes
+                    \brief The values.
+                 */
+                std::array<T, L> lanes;
+            };
+
+            /** \fn constexpr auto operator*(lockstep<T, L> lhs, lockstep<T, L> const &rhs) noexcept -> lockstep<T, L>
+                \brief Multiplies lane by lane.
+             */
+            template <typename T, std::size_t L>
+            constexpr auto operator*(lockstep<T, L> lhs, lockstep<T, L> const &rhs) noexcept -> lockstep<T, L>;
+
         } // namespace impl_details
 
-        /** \class int_mod<N>
+        template <s64 N, typename Reduction>
+        class shoup_multiplier;
+
+        /** \class int_mod<N, Reduction>
             \brief Wrapper for 64-bit integer for arithmetic modulo N.
+            \details Reduction selects how products are reduced modulo N: remainder_reduction (the default) or
+                     barrett_reduction.
          */
-        template <s64 N>
+        template <s64 N, typename Reduction = remainder_reduction>
         class int_mod
         {
             static_assert(N > 1, "Modulus N of int_mod<N> must be at least 2.");
-            static_assert(N <= 1000000000, "Modulus N > 100000000 of int_mod<N> are currently not supported due to lack of adequate overflow checks.");
 
         private:
             /** \property s64 element_
@@ -86,12 +347,14 @@ namespace math_nerd
              */
             s64 element_{ 0 };
 
+            friend class shoup_multiplier<N, Reduction>;
+
         public:
             constexpr int_mod() = default;
 
             constexpr int_mod(s64 num) noexcept
             {
-                element_ = impl_details::standard_modulo<N>(num);
+                element_ = impl_details::standard_modulo<N, Reduction>(num);
                 element_ %= N;
             }
 
@@ -116,18 +379,56 @@ namespace math_nerd
              */
             constexpr auto inverse() const -> s64
             {
-                s64 inv;
-                try
-                {
-                    inv = impl_details::inverse_of<N>(element_);
-                }
-                catch( std::invalid_argument const & )
+                return impl_details::inverse_of<N>(element_);
+            }
+
+            /** \fn constexpr auto pow(s64 const exponent) const -> int_mod<N>
+                \brief Returns the stored value raised to exponent. Throws std::invalid_argument if exponent is negative.
+             */
+            constexpr auto pow(s64 const exponent) const -> int_mod<N, Reduction>
+            {
+                if( exponent < 0 )
                 {
-                    throw;
+                    throw std::invalid_argument{ "Exponent must be non-negative." };
                 }
-                return inv;
+
+                return impl_details::pow_binary(*this, int_mod<N, Reduction>{ 1 }, static_cast<u64>(exponent));
+            }
+
+            /** \fn constexpr auto pow() const noexcept -> int_mod<N>
+                \brief Returns the stored value raised to the compile-time exponent E with a fully unrolled multiplication chain.
+             */
+            template <s64 E>
+            constexpr auto pow() const noexcept -> int_mod<N, Reduction>
+            {
+                static_assert(E >= 0, "Exponent E of int_mod<N>::pow<E>() must be non-negative.");
+
+                return impl_details::pow_unrolled<static_cast<u64>(E)>(*this, int_mod<N, Reduction>{ 1 });
             }
 
+            /** \fn constexpr auto try_inverse() const noexcept -> std::optional<int_mod<N>>
+                \brief Returns the inverse modulo N of the stored value, or std::nullopt if not invertible.
+             */
+            constexpr auto try_inverse() const noexcept -> std::optional<int_mod<N, Reduction>>;
+
+            /** \fn constexpr auto checked_div(int_mod<N> const rhs) const noexcept -> std::optional<int_mod<N>>
+                \brief Returns *this divided by rhs, or std::nullopt if rhs is not invertible.
+             */
+            constexpr auto checked_div(int_mod<N, Reduction> const rhs) const noexcept -> std::optional<int_mod<N, Reduction>>;
+
+            /** \fn constexpr auto sqrt() const noexcept -> std::optional<int_mod<N>>
+                \brief Returns the smaller square root of the stored value modulo the prime N, or std::nullopt if there is none.
+                \details The method is fixed at compile time: \f$a^{(N+1)/4}\f$ when \f$N \equiv 3 \pmod 4\f$, Atkin's
+                         formula, also one exponentiation, when \f$N \equiv 5 \pmod 8\f$, and otherwise Tonelli-Shanks with
+                         a precomputed non-residue, costing up to \f$s^2/2\f$ more squarings for \f$2^s \mid N - 1\f$.
+             */
+            constexpr auto sqrt() const noexcept -> std::optional<int_mod<N, Reduction>>;
+
+            /** \fn constexpr auto checked_div(s64 const rhs) const noexcept -> std::optional<int_mod<N>>
+                \brief Returns *this divided by rhs, or std::nullopt if rhs is not invertible.
+             */
+            constexpr auto checked_div(s64 const rhs) const noexcept -> std::optional<int_mod<N, Reduction>>;
+
             /** \fn constexpr explicit operator s64() const
                 \brief Explicit type conversion back to a signed 64-bit integer.
              */
@@ -140,79 +441,79 @@ namespace math_nerd
             /** \fn constexpr auto operator++() noexcept -> int_mod<N> &
                 \brief Pre-increments element_ and reduces modulo N.
              */
-            constexpr auto operator++() noexcept -> int_mod<N> &;
+            constexpr auto operator++() noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator++(int) noexcept -> int_mod<N>
                 \brief Post-increments element_ and reduces modulo N.
              */
-            constexpr auto operator++(int) noexcept -> int_mod<N>;
+            constexpr auto operator++(int) noexcept -> int_mod<N, Reduction>;
 
             /** \fn constexpr auto operator--() noexcept -> int_mod<N> &
                 \brief Pre-decrements element_ and reduces modulo N.
              */
-            constexpr auto operator--() noexcept -> int_mod<N> &;
+            constexpr auto operator--() noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator--(int) noexcept -> int_mod<N>
                 \brief Post-decrements element_ and reduces modulo N.
              */
-            constexpr auto operator--(int) noexcept -> int_mod<N>;
+            constexpr auto operator--(int) noexcept -> int_mod<N, Reduction>;
 
             /** \name Unary operators */
             /** \fn constexpr auto operator+() const noexcept -> int_mod<N>
                 \brief Returns the *this.
              */
-            constexpr auto operator+() const noexcept -> int_mod<N>;
+            constexpr auto operator+() const noexcept -> int_mod<N, Reduction>;
 
             /** \fn constexpr auto operator-() const noexcept -> int_mod<N>
                 \brief Returns the additive inverse modulo N.
              */
-            constexpr auto operator-() const noexcept -> int_mod<N>;
+            constexpr auto operator-() const noexcept -> int_mod<N, Reduction>;
 
             /** \name Assignment operators */
             /** \fn constexpr auto operator+=(int_mod<N> const rhs) noexcept -> int_mod<N> &
                 \brief Adds rhs to element_ and reduces modulo N.
              */
-            constexpr auto operator+=(int_mod<N> const rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator+=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator-=(int_mod<N> const rhs) noexcept -> int_mod<N> &
                 \brief Subtracts rhs from element_ and reduces modulo N.
              */
-            constexpr auto operator-=(int_mod<N> const rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator-=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator*=(int_mod<N> const rhs) noexcept -> int_mod<N> &
                 \brief Multiples rhs to element_ and reduces modulo N.
              */
-            constexpr auto operator*=(int_mod<N> const rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator*=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator/=(int_mod<N> const rhs) -> int_mod<N> &
                 \brief Divides rhs, if invertible modulo N, from element_ and reduces modulo N. Throws std::invalid_argument if rhs is not invertible.
              */
-            constexpr auto operator/=(int_mod<N> const rhs) -> int_mod<N> &;
+            constexpr auto operator/=(int_mod<N, Reduction> const rhs) -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator=(s64 rhs) noexcept -> int_mod<N> &
                 \brief Assigns rhs to element_ and reduces modulo N.
              */
-            constexpr auto operator=(s64 rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator=(s64 rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator+=(s64 rhs) noexcept -> int_mod<N> &
                 \brief Adds rhs to element_ and reduces modulo N.
              */
-            constexpr auto operator+=(s64 rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator+=(s64 rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator-=(s64 rhs) noexcept -> int_mod<N> &
                 \brief Subtracts rhs from element_ and reduces modulo N.
              */
-            constexpr auto operator-=(s64 rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator-=(s64 rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator*=(s64 rhs) noexcept -> int_mod<N> &
                 \brief Multiples rhs to element_ and reduces modulo N.
              */
-            constexpr auto operator*=(s64 rhs) noexcept -> int_mod<N> &;
+            constexpr auto operator*=(s64 rhs) noexcept -> int_mod<N, Reduction> &;
 
             /** \fn constexpr auto operator/=(s64 rhs) -> int_mod<N> &
                 \brief Divides rhs, if invertible modulo N, from element_ and reduces modulo N. Throws std::invalid_argument if rhs is not invertible.
              */
-            constexpr auto operator/=(s64 rhs) -> int_mod<N> &;
+            constexpr auto operator/=(s64 rhs) -> int_mod<N, Reduction> &;
 
 
             /** \name Comparison operators */
@@ -220,12 +521,12 @@ namespace math_nerd
             /** \fn constexpr auto operator==(int_mod<N> const rhs) const noexcept -> bool
                 \brief Compares the values and returns true if equal.
              */
-            constexpr auto operator==(int_mod<N> const rhs) const noexcept -> bool;
+            constexpr auto operator==(int_mod<N, Reduction> const rhs) const noexcept -> bool;
 
             /** \fn  constexpr auto operator!=(int_mod<N> const rhs) const noexcept -> bool
                 \brief Compares the values and returns false if equal.
              */
-            constexpr auto operator!=(int_mod<N> const rhs) const noexcept -> bool;
+            constexpr auto operator!=(int_mod<N, Reduction> const rhs) const noexcept -> bool;
 
             // s64 versions
             /** \fn constexpr auto operator==(s64 rhs) const noexcept -> bool
@@ -239,9 +540,37 @@ namespace math_nerd
             constexpr auto operator!=(s64 rhs) const noexcept -> bool;
         };
 
+        namespace impl_details
+        {
+            /** \fn constexpr auto sqrt_finish(int_mod<N> const a, int_mod<N> const w) noexcept -> std::optional<int_mod<N>>
+                \brief Completes int_mod<N>::sqrt() given \f$w = a^E\f$, E being sqrt_traits<N>::exponent.
+             */
+            template <s64 N, typename Reduction>
+            constexpr auto sqrt_finish(int_mod<N, Reduction> const a, int_mod<N, Reduction> const w) noexcept
+                -> std::optional<int_mod<N, Reduction>>;
+
+            /** \var is_int_mod<T>
+                \brief True if T is an int_mod<N, Reduction>.
+             */
+            template <typename T>
+            inline constexpr bool is_int_mod{ false };
+
+            template <s64 N, typename Reduction>
+            inline constexpr bool is_int_mod<int_mod<N, Reduction>>{ true };
+
+            /** \concept int_mod_range<R>
+                \brief True if R is a contiguous range of int_mod<N, Reduction>, such as a std::vector or std::array,
+                       which a span of const int_mod<N, Reduction> can view.
+             */
+            template <typename R>
+            concept int_mod_range = std::ranges::contiguous_range<R const> && std::ranges::sized_range<R const>
+                                    && is_int_mod<std::ranges::range_value_t<R>>;
+
+        } // namespace impl_details
+
         // Increment/Decrement Operators
-        template <s64 N>
-        constexpr auto int_mod<N>::operator++() noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator++() noexcept -> int_mod<N, Reduction> &
         {
             if( element_ == N - 1 )
             {
@@ -255,16 +584,16 @@ namespace math_nerd
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator++(int) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator++(int) noexcept -> int_mod<N, Reduction>
         {
-            int_mod<N> tmp(*this);
+            int_mod<N, Reduction> tmp(*this);
             operator++();
             return tmp;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator--() noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator--() noexcept -> int_mod<N, Reduction> &
         {
             if( element_ == 0 )
             {
@@ -278,45 +607,49 @@ namespace math_nerd
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator--(int) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator--(int) noexcept -> int_mod<N, Reduction>
         {
-            int_mod<N> tmp(*this);
+            int_mod<N, Reduction> tmp(*this);
             operator--();
             return tmp;
         }
 
         // Unary operators
-        template <s64 N>
-        constexpr auto int_mod<N>::operator+() const noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator+() const noexcept -> int_mod<N, Reduction>
         {
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator-() const noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator-() const noexcept -> int_mod<N, Reduction>
         {
             return N - element_;
         }
 
         // Assignment operators
         // int_mod<N> versions
-        template <s64 N>
-        constexpr auto int_mod<N>::operator+=(int_mod<N> const rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator+=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &
         {
-            element_ += rhs.value();
-            element_ %= N;
+            element_ -= N - rhs.value();
+
+            if( element_ < 0 )
+            {
+                element_ += N;
+            }
 
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator-=(int_mod<N> const rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator-=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &
         {
             if( rhs.value() > element_ )
             {
                 element_ += N - rhs.value();
-                element_ = impl_details::standard_modulo<N>(element_);
+                element_ = impl_details::standard_modulo<N, Reduction>(element_);
             }
             else
             {
@@ -326,59 +659,98 @@ namespace math_nerd
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator*=(int_mod<N> const rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator*=(int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction> &
         {
-            element_ *= rhs.value();
-            element_ %= N;
+            element_ = impl_details::mul_mod<N, Reduction>(element_, rhs.value());
 
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator/=(int_mod<N> const rhs) -> int_mod<N> &
+        // Non-throwing inversion and division
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::try_inverse() const noexcept -> std::optional<int_mod<N, Reduction>>
         {
-            try
+            if( auto const inv = impl_details::try_inverse_of<N>(element_) )
             {
-                element_ *= rhs.inverse();
-                element_ %= N;
+                return int_mod<N, Reduction>{ *inv };
+            }
+
+            return std::nullopt;
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::checked_div(int_mod<N, Reduction> const rhs) const noexcept -> std::optional<int_mod<N, Reduction>>
+        {
+            if( auto const inv = rhs.try_inverse() )
+            {
+                return *this * *inv;
+            }
+
+            return std::nullopt;
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::checked_div(s64 const rhs) const noexcept -> std::optional<int_mod<N, Reduction>>
+        {
+            return checked_div(int_mod<N, Reduction>{ rhs });
+        }
+
+        // Square roots
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::sqrt() const noexcept -> std::optional<int_mod<N, Reduction>>
+        {
+            static_assert(impl_details::prime_modulus<N>, "int_mod<N>::sqrt() requires a prime modulus N.");
+
+            if constexpr( N == 2 )
+            {
+                return *this;
             }
-            catch( std::invalid_argument const & )
+            else
             {
-                throw;
+                return impl_details::sqrt_finish(*this, pow<static_cast<s64>(impl_details::sqrt_traits<N>::exponent)>());
             }
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator/=(int_mod<N, Reduction> const rhs) -> int_mod<N, Reduction> &
+        {
+            element_ = impl_details::mul_mod<N, Reduction>(element_, rhs.inverse());
 
             return *this;
         }
 
         // s64 versions
-        template <s64 N>
-        constexpr auto int_mod<N>::operator=(s64 rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator=(s64 rhs) noexcept -> int_mod<N, Reduction> &
         {
-            element_ = impl_details::standard_modulo<N>(rhs);
+            element_ = impl_details::standard_modulo<N, Reduction>(rhs);
 
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator+=(s64 rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator+=(s64 rhs) noexcept -> int_mod<N, Reduction> &
         {
-            element_ += impl_details::standard_modulo<N>(rhs);
+            element_ -= N - impl_details::standard_modulo<N, Reduction>(rhs);
 
-            element_ %= N;
+            if( element_ < 0 )
+            {
+                element_ += N;
+            }
 
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator-=(s64 rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator-=(s64 rhs) noexcept -> int_mod<N, Reduction> &
         {
-            rhs = impl_details::standard_modulo<N>(rhs);
+            rhs = impl_details::standard_modulo<N, Reduction>(rhs);
 
             if( rhs > element_ )
             {
                 element_ += N - rhs;
-                element_ = impl_details::standard_modulo<N>(element_);
+                element_ = impl_details::standard_modulo<N, Reduction>(element_);
             }
             else
             {
@@ -388,60 +760,51 @@ namespace math_nerd
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator*=(s64 rhs) noexcept -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator*=(s64 rhs) noexcept -> int_mod<N, Reduction> &
         {
-            element_ *= impl_details::standard_modulo<N>(rhs);
-            element_ %= N;
+            element_ = impl_details::mul_mod<N, Reduction>(element_, impl_details::standard_modulo<N, Reduction>(rhs));
 
             return *this;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator/=(s64 rhs) -> int_mod<N> &
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator/=(s64 rhs) -> int_mod<N, Reduction> &
         {
-            try
-            {
-                rhs = impl_details::inverse_of<N>(rhs);
-            }
-            catch( std::invalid_argument const & )
-            {
-                throw;
-            }
+            rhs = impl_details::inverse_of<N>(rhs);
 
-            element_ *= rhs;
-            element_ %= N;
+            element_ = impl_details::mul_mod<N, Reduction>(element_, rhs);
 
             return *this;
         }
 
         // Comparison operators
         // int_mod<N> versions
-        template <s64 N>
-        constexpr auto int_mod<N>::operator==(int_mod<N> const rhs) const noexcept -> bool
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator==(int_mod<N, Reduction> const rhs) const noexcept -> bool
         {
             return element_ == rhs.value();
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator!=(int_mod<N> const rhs) const noexcept -> bool
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator!=(int_mod<N, Reduction> const rhs) const noexcept -> bool
         {
             return element_ != rhs.value();
         }
 
         // s64 versions
-        template <s64 N>
-        constexpr auto int_mod<N>::operator==(s64 rhs) const noexcept -> bool
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator==(s64 rhs) const noexcept -> bool
         {
-            rhs = impl_details::standard_modulo<N>(rhs);
+            rhs = impl_details::standard_modulo<N, Reduction>(rhs);
 
             return element_ == rhs;
         }
 
-        template <s64 N>
-        constexpr auto int_mod<N>::operator!=(s64 rhs) const noexcept -> bool
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod<N, Reduction>::operator!=(s64 rhs) const noexcept -> bool
         {
-            rhs = impl_details::standard_modulo<N>(rhs);
+            rhs = impl_details::standard_modulo<N, Reduction>(rhs);
 
             return element_ != rhs;
         }
@@ -452,8 +815,8 @@ namespace math_nerd
         /** \fn constexpr auto operator+(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of adding two int_mod<N>.
          */
-        template <s64 N>
-        constexpr auto operator+(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator+(int_mod<N, Reduction> lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             lhs += rhs;
             return lhs;
@@ -462,8 +825,8 @@ namespace math_nerd
         /** \fn constexpr auto operator-(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of subtracting two int_mod<N>.
          */
-        template <s64 N>
-        constexpr auto operator-(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator-(int_mod<N, Reduction> lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             if( lhs.value() < rhs.value() )
             {
@@ -480,8 +843,8 @@ namespace math_nerd
         /** \fn constexpr auto operator*(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of multiplying two int_mod<N>.
          */
-        template <s64 N>
-        constexpr auto operator*(int_mod<N> lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator*(int_mod<N, Reduction> lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             lhs *= rhs;
 
@@ -491,17 +854,10 @@ namespace math_nerd
         /** \fn constexpr auto operator/(int_mod<N> lhs, int_mod<N> rhs) -> int_mod<N>
             \brief Returns the result of dividing two int_mod<N>. Throws std::invalid_argument if rhs is not invertible.
          */
-        template <s64 N>
-        constexpr auto operator/(int_mod<N> lhs, int_mod<N> rhs) -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator/(int_mod<N, Reduction> lhs, int_mod<N, Reduction> rhs) -> int_mod<N, Reduction>
         {
-            try
-            {
-                lhs /= rhs.value();
-            }
-            catch( std::invalid_argument const & )
-            {
-                throw;
-            }
+            lhs /= rhs.value();
 
             return lhs;
         }
@@ -510,8 +866,8 @@ namespace math_nerd
         /** \fn constexpr auto operator+(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
             \brief Returns the result of adding int_mod<N> and s64.
          */
-        template <s64 N>
-        constexpr auto operator+(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator+(int_mod<N, Reduction> lhs, s64 rhs) noexcept -> int_mod<N, Reduction>
         {
             lhs += rhs;
 
@@ -521,8 +877,8 @@ namespace math_nerd
         /** \fn constexpr auto operator-(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
             \brief Returns the result of subtracting int_mod<N> by s64.
          */
-        template <s64 N>
-        constexpr auto operator-(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator-(int_mod<N, Reduction> lhs, s64 rhs) noexcept -> int_mod<N, Reduction>
         {
             lhs -= rhs;
 
@@ -532,8 +888,8 @@ namespace math_nerd
         /** \fn constexpr auto operator*(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
             \brief Returns the result of multiplying int_mod<N> by s64.
          */
-        template <s64 N>
-        constexpr auto operator*(int_mod<N> lhs, s64 rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator*(int_mod<N, Reduction> lhs, s64 rhs) noexcept -> int_mod<N, Reduction>
         {
             lhs *= rhs;
 
@@ -543,17 +899,10 @@ namespace math_nerd
         /** \fn constexpr auto operator/(int_mod<N> lhs, s64 rhs) -> int_mod<N>
             \brief Returns the result of dividing int_mod<N> by s64. Throws std::invalid_argument if rhs is not invertible.
          */
-        template <s64 N>
-        constexpr auto operator/(int_mod<N> lhs, s64 rhs) -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator/(int_mod<N, Reduction> lhs, s64 rhs) -> int_mod<N, Reduction>
         {
-            try
-            {
-                lhs /= rhs;
-            }
-            catch( std::invalid_argument const & )
-            {
-                throw;
-            }
+            lhs /= rhs;
 
             return lhs;
         }
@@ -562,8 +911,8 @@ namespace math_nerd
         /** \fn constexpr auto operator+(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of adding int_mod<N> and s64.
          */
-        template <s64 N>
-        constexpr auto operator+(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator+(s64 const lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             rhs += lhs;
 
@@ -573,8 +922,8 @@ namespace math_nerd
         /** \fn constexpr auto operator-(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of subtracting int_mod<N> by s64.
          */
-        template <s64 N>
-        constexpr auto operator-(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator-(s64 const lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             if( (lhs % N) < rhs.value() )
             {
@@ -591,8 +940,8 @@ namespace math_nerd
         /** \fn constexpr auto operator*(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
             \brief Returns the result of multiplying int_mod<N> by s64.
          */
-        template <s64 N>
-        constexpr auto operator*(s64 const lhs, int_mod<N> rhs) noexcept -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator*(s64 const lhs, int_mod<N, Reduction> rhs) noexcept -> int_mod<N, Reduction>
         {
             rhs *= lhs;
 
@@ -602,25 +951,18 @@ namespace math_nerd
         /** \fn constexpr auto operator/(s64 const lhs, int_mod<N> rhs) -> int_mod<N>
             \brief Returns the result of dividing int_mod<N> by s64. Throws std::invalid_argument if rhs is not invertible.
          */
-        template <s64 N>
-        constexpr auto operator/(s64 const lhs, int_mod<N> rhs) -> int_mod<N>
+        template <s64 N, typename Reduction>
+        constexpr auto operator/(s64 const lhs, int_mod<N, Reduction> rhs) -> int_mod<N, Reduction>
         {
-            try
-            {
-                return rhs.inverse() * lhs;
-            }
-            catch( std::invalid_argument const & )
-            {
-                throw;
-            }
+            return int_mod<N, Reduction>{ rhs.inverse() } * lhs;
         }
 
         // I/O operators
         /** \fn constexpr auto operator<<(std::ostream &os, int_mod<N> const &rhs) -> std::ostream &
             \brief Outputs our number in standard form. Returns the ostream object for further output.
          */
-        template <s64 N>
-        constexpr auto operator<<(std::ostream &os, int_mod<N> const &rhs) -> std::ostream &
+        template <s64 N, typename Reduction>
+        constexpr auto operator<<(std::ostream &os, int_mod<N, Reduction> const &rhs) -> std::ostream &
         {
             os << rhs.value();
             return os;
@@ -629,133 +971,848 @@ namespace math_nerd
         /** \fn constexpr auto operator>>(std::istream &is, int_mod<N> &rhs) -> std::istream &
             \brief Inputs our number in standard form. Returns the istream object for further input.
          */
-        template <s64 N>
-        constexpr auto operator>>(std::istream &is, int_mod<N> &rhs) -> std::istream &
+        template <s64 N, typename Reduction>
+        constexpr auto operator>>(std::istream &is, int_mod<N, Reduction> &rhs) -> std::istream &
         {
             s64 tmp;
             is >> tmp;
 
-            rhs = impl_details::standard_modulo<N>(tmp);
+            rhs = impl_details::standard_modulo<N, Reduction>(tmp);
 
             return is;
         }
 
-        // Implementation function definitions.
-        namespace impl_details
+        // Batch operations
+        /** \fn auto batch_inverse(std::span<T> const values) -> std::size_t
+            \brief Replaces every element of values by its inverse using Montgomery's trick.
+            \details Costs one inversion and 3(n - 1) multiplications. T may be any of the modular integer types
+                     (int_mod<N, Reduction>, montgomery_int_mod<N>, dynamic_int_mod). Never throws for non-invertible input:
+                     returns the index of the first non-invertible element and leaves values untouched, or returns
+                     values.size() if every element was inverted.
+         */
+        template <typename T>
+        auto batch_inverse(std::span<T> const values) -> std::size_t
         {
-            constexpr auto gcd(s64 a, s64 b) noexcept -> s64
+            if( values.empty() )
             {
-                if( a < 0 ) a *= -1;
-                if( b < 0 ) b *= -1;
-
-                if( b == 0 )
-                {
-                    return a;
-                }
-
-                return gcd(b, a % b);
+                return 0;
             }
 
-            constexpr auto euler_phi(s64 N) noexcept -> s64
+            // prefix[i] = values[0] * ... * values[i]
+            std::vector<T> prefix(values.begin(), values.end());
+
+            for( std::size_t i{ 1 }; i < prefix.size(); ++i )
             {
-                s64 res = N;
+                prefix[i] *= prefix[i - 1];
+            }
 
-                for( auto p{ 2 }; p * p <= N; ++p )
-                {   // Check all numbers <= sqrt(n)
-                    if( N % p == 0 )
-                    {   // If we find a factor, it is prime
-                        while( N % p == 0 )
-                        { // so we divide it out until it's all gone.
-                            N /= p;
-                        }
+            T acc{ prefix.back() };
+            auto const [d, inv] = impl_details::gcd_and_inverse(acc.value(), acc.modulus());
 
-                        res -= res / p; // and update res by multiplying by (1-1/p).
+            if( d != 1 )
+            {   // The product is invertible iff every factor is, so find the culprit.
+                for( std::size_t i{ 0 }; i < values.size(); ++i )
+                {
+                    if( impl_details::gcd(values[i].value(), values[i].modulus()) != 1 )
+                    {
+                        return i;
                     }
                 }
+            }
 
-                if( N > 1 )
-                {   // If we have any factors > sqrt(n), then there is at most one
-                    res -= res / N; // and we update res accordingly.
-                }
+            acc = inv; // acc = (values[0] * ... * values[n - 1])^(-1)
 
-                return res;
+            for( std::size_t i{ values.size() - 1 }; i > 0; --i )
+            {
+                T const inverse_i{ acc * prefix[i - 1] };
+                acc *= values[i];
+                values[i] = inverse_i;
             }
 
-            template<s64 N>
-            constexpr auto ipow(s64 const base, s64 const exponent) -> s64
-            {
-                if( exponent < 0 )
-                {
-                    throw std::invalid_argument{ "Exponent must be non-negative." };
-                }
+            values[0] = acc;
 
-                if( base == 0 || base == 1 || exponent == 1 )
-                {
-                    return base;
-                }
-                else if( exponent == 0 )
-                {
-                    return 1;
-                }
+            return values.size();
+        }
 
-                s64 tmp = ipow<N>(base, exponent / 2);
+        /** \fn auto batch_sqrt(std::span<int_mod<N> const> const values) -> std::vector<std::optional<int_mod<N>>>
+            \brief Returns the sqrt() of every element of values.
+            \details The exponentiation is the costly part and is the same for every element, so it runs on four
+                     elements at a time in lockstep: the four multiplication chains are independent and overlap in the
+                     pipeline, where one chain alone would wait on each product.
+         */
+        template <s64 N, typename Reduction>
+        auto batch_sqrt(std::span<int_mod<N, Reduction> const> const values) -> std::vector<std::optional<int_mod<N, Reduction>>>
+        {
+            static_assert(impl_details::prime_modulus<N>, "batch_sqrt() requires a prime modulus N.");
 
-                if( exponent % 2 == 0 )
-                {
-                    return standard_modulo<N>(tmp * tmp);
-                }
-                else
-                {   // Circumventing some overflows by modding by N before second multiplication by tmp.
-                    return standard_modulo<N>(((base * tmp) % N) * tmp);
-                }
-            }
+            using T = int_mod<N, Reduction>;
+            constexpr std::size_t L{ 4 };
 
-            template <s64 N>
-            constexpr auto inverse_of(s64 n) -> s64
-            {
+            std::vector<std::optional<T>> result(values.size());
+            std::size_t i{ 0 };
 
-                constexpr s64 phi{ euler_phi(N) };
+            if constexpr( N > 2 )
+            {
+                using lanes = impl_details::lockstep<T, L>;
+                constexpr u64 E{ impl_details::sqrt_traits<N>::exponent };
 
-                s64 inv{ 0 };
-                s64 d{ gcd(n, N) };
+                lanes one;
+                one.lanes.fill(T{ 1 });
 
-                if( d == 1 )
+                for( ; i + L <= values.size(); i += L )
                 {
-                    try
+                    lanes base;
+                    std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(i), L, base.lanes.begin());
+
+                    lanes const w{ impl_details::pow_unrolled<E>(base, one) };
+
+                    for( std::size_t k{ 0 }; k < L; ++k )
                     {
-                        inv = ipow<N>(standard_modulo<N>(n) % N, phi - 1);
+                        result[i + k] = impl_details::sqrt_finish(base.lanes[k], w.lanes[k]);
                     }
-                    catch( std::invalid_argument const & )
+                }
+            }
+
+            for( ; i < values.size(); ++i )
+            {
+                result[i] = values[i].sqrt();
+            }
+
+            return result;
+        }
+
+        /** \fn auto batch_sqrt(R const &values) -> std::vector<std::optional<int_mod<N>>>
+            \brief batch_sqrt() over a contiguous container of int_mod<N>, such as a std::vector.
+         */
+        template <impl_details::int_mod_range R>
+        auto batch_sqrt(R const &values) -> std::vector<std::optional<std::ranges::range_value_t<R>>>
+        {
+            return batch_sqrt(std::span<std::ranges::range_value_t<R> const>{ values });
+        }
+
+        /** \fn constexpr auto jacobi(int_mod<N> const a) noexcept -> int
+            \brief Returns the Jacobi symbol \f$(a/N)\f$: for prime N, 1 if a is a nonzero square, -1 if it is not a square and 0 if a is 0.
+            \details Uses the binary Jacobi algorithm, which needs no multiplications, rather than Euler's criterion.
+                     vector_jacobi() in int_mod_vector.h computes many symbols at once.
+         */
+        template <s64 N, typename Reduction>
+        constexpr auto jacobi(int_mod<N, Reduction> const a) noexcept -> int
+        {
+            static_assert(N % 2 == 1, "jacobi() requires an odd modulus N.");
+
+            return impl_details::jacobi_symbol(static_cast<u64>(a.value()), static_cast<u64>(N));
+        }
+
+        // Shoup multiplication
+        /** \class shoup_multiplier<N, Reduction>
+            \brief A fixed factor w modulo N, stored with \f$w' = \lfloor w 2^{64} / N \rfloor\f$ so that multiplying
+                   by it needs no division.
+            \details For x in [0, N), \f$q = \lfloor x w' / 2^{64} \rfloor\f$ is the quotient of x w by N or one
+                     less. So x w - q N, computed modulo \f$2^{64}\f$, lies in [0, 2N) and one conditional
+                     subtraction finishes. That is one high multiply, two low multiplies and a compare, for any
+                     \f$N < 2^{63}\f$. Computing w' costs a division, so this pays off when w is reused, as
+                     twiddle factors and scalars are. int_mod<N> * shoup_multiplier<N> picks it up wherever the
+                     factor is stored as one.
+         */
+        template <s64 N, typename Reduction = remainder_reduction>
+        class shoup_multiplier
+        {
+        private:
+            /** \property u64 value_
+                \brief The factor w, in [0, N).
+             */
+            u64 value_{ 0 };
+
+            /** \property u64 quotient_
+                \brief \f$\lfloor w 2^{64} / N \rfloor\f$.
+             */
+            u64 quotient_{ 0 };
+
+        public:
+            /** \fn constexpr shoup_multiplier()
+                \brief Multiplies by zero.
+             */
+            constexpr shoup_multiplier() = default;
+
+            /** \fn constexpr shoup_multiplier(int_mod<N> const w) noexcept
+                \brief Precomputes the quotient for w.
+             */
+            constexpr shoup_multiplier(int_mod<N, Reduction> const w) noexcept;
+
+            /** \fn constexpr auto value() const noexcept -> int_mod<N>
+                \brief Returns w.
+             */
+            constexpr auto value() const noexcept -> int_mod<N, Reduction>
+            {
+                return int_mod<N, Reduction>{ static_cast<s64>(value_) };
+            }
+
+            /** \fn constexpr auto quotient() const noexcept -> u64
+                \brief Returns \f$\lfloor w 2^{64} / N \rfloor\f$.
+             */
+            constexpr auto quotient() const noexcept -> u64
+            {
+                return quotient_;
+            }
+
+            /** \fn constexpr auto multiply(int_mod<N> const x) const noexcept -> int_mod<N>
+                \brief Returns x w.
+             */
+            constexpr auto multiply(int_mod<N, Reduction> const x) const noexcept -> int_mod<N, Reduction>;
+        };
+
+        /** \fn constexpr auto operator*(int_mod<N> const lhs, shoup_multiplier<N> const &rhs) noexcept -> int_mod<N>
+            \brief Returns lhs times the factor of rhs.
+         */
+        template <s64 N, typename Reduction>
+        constexpr auto operator*(int_mod<N, Reduction> const lhs, shoup_multiplier<N, Reduction> const &rhs) noexcept -> int_mod<N, Reduction>
+        {
+            return rhs.multiply(lhs);
+        }
+
+        /** \fn constexpr auto operator*(shoup_multiplier<N> const &lhs, int_mod<N> const rhs) noexcept -> int_mod<N>
+            \brief Returns rhs times the factor of lhs.
+         */
+        template <s64 N, typename Reduction>
+        constexpr auto operator*(shoup_multiplier<N, Reduction> const &lhs, int_mod<N, Reduction> const rhs) noexcept -> int_mod<N, Reduction>
+        {
+            return lhs.multiply(rhs);
+        }
+
+        /** \fn constexpr auto operator*=(int_mod<N> &lhs, shoup_multiplier<N> const &rhs) noexcept -> int_mod<N> &
+            \brief Multiplies lhs by the factor of rhs.
+         */
+        template <s64 N, typename Reduction>
+        constexpr auto operator*=(int_mod<N, Reduction> &lhs, shoup_multiplier<N, Reduction> const &rhs) noexcept -> int_mod<N, Reduction> &
+        {
+            lhs = rhs.multiply(lhs);
+            return lhs;
+        }
+
+        /** \typedef fixed_multiplier<N, Reduction>
+            \brief How to store a factor that many values are multiplied by: shoup_multiplier<N> when products modulo N
+                   need 128 bits, int_mod<N> otherwise, since a 64-bit product reduced by a constant is just as fast.
+         */
+        template <s64 N, typename Reduction = remainder_reduction>
+        using fixed_multiplier = std::conditional_t<impl_details::fits_narrow<N>(), int_mod<N, Reduction>, shoup_multiplier<N, Reduction>>;
+
+        template <s64 N, typename Reduction>
+        constexpr shoup_multiplier<N, Reduction>::shoup_multiplier(int_mod<N, Reduction> const w) noexcept
+            : value_{ static_cast<u64>(w.value()) }
+        {
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            quotient_ = static_cast<u64>((static_cast<u128>(value_) << 64) / static_cast<u64>(N));
+#else
+            // Long division of w 2^64 by N; the remainder stays below N < 2^63, so doubling it cannot overflow.
+            u64 remainder{ value_ };
+
+            for( int bit{ 0 }; bit < 64; ++bit )
+            {
+                remainder <<= 1;
+                quotient_ <<= 1;
+
+                if( remainder >= static_cast<u64>(N) )
+                {
+                    remainder -= static_cast<u64>(N);
+                    quotient_ |= 1;
+                }
+            }
+#endif
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto shoup_multiplier<N, Reduction>::multiply(int_mod<N, Reduction> const x) const noexcept -> int_mod<N, Reduction>
+        {
+            u64 const a{ static_cast<u64>(x.value()) };
+            u64 const q{ impl_details::mul_hi(a, quotient_) };
+            u64 r{ a * value_ - q * static_cast<u64>(N) };
+
+            if( r >= static_cast<u64>(N) )
+            {
+                r -= static_cast<u64>(N);
+            }
+
+            int_mod<N, Reduction> result;
+            result.element_ = static_cast<s64>(r);
+            return result;
+        }
+
+        // Implementation function definitions.
+        namespace impl_details
+        {
+            constexpr auto gcd(s64 a, s64 b) noexcept -> s64
+            {
+                if( a < 0 ) a *= -1;
+                if( b < 0 ) b *= -1;
+
+                if( b == 0 )
+                {
+                    return a;
+                }
+
+                return gcd(b, a % b);
+            }
+
+            constexpr auto euler_phi(s64 N) noexcept -> s64
+            {
+                s64 res = N;
+
+                for( s64 p{ 2 }; p <= N / p; ++p )
+                {   // Check all numbers <= sqrt(n)
+                    if( N % p == 0 )
+                    {   // If we find a factor, it is prime
+                        while( N % p == 0 )
+                        { // so we divide it out until it's all gone.
+                            N /= p;
+                        }
+
+                        res -= res / p; // and update res by multiplying by (1-1/p).
+                    }
+                }
+
+                if( N > 1 )
+                {   // If we have any factors > sqrt(n), then there is at most one
+                    res -= res / N; // and we update res accordingly.
+                }
+
+                return res;
+            }
+
+            template <s64 N>
+            constexpr auto fits_narrow() noexcept -> bool
+            {
+                return N - 1 <= std::numeric_limits<s64>::max() / (N - 1);
+            }
+
+            constexpr auto mul_hi(u64 const a, u64 const b) noexcept -> u64
+            {
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+                return static_cast<u64>((static_cast<u128>(a) * b) >> 64);
+#else
+                u64 const a_lo{ a & 0xFFFFFFFFu };
+                u64 const a_hi{ a >> 32 };
+                u64 const b_lo{ b & 0xFFFFFFFFu };
+                u64 const b_hi{ b >> 32 };
+
+                u64 const lo_lo{ a_lo * b_lo };
+                u64 const hi_lo{ a_hi * b_lo };
+                u64 const lo_hi{ a_lo * b_hi };
+                u64 const cross{ (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi };
+
+                return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+            }
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+            constexpr auto mul_hi(u128 const a, u128 const b) noexcept -> u128
+            {
+                u128 const a_lo{ static_cast<u64>(a) };
+                u128 const a_hi{ a >> 64 };
+                u128 const b_lo{ static_cast<u64>(b) };
+                u128 const b_hi{ b >> 64 };
+
+                u128 const lo_lo{ a_lo * b_lo };
+                u128 const hi_lo{ a_hi * b_lo };
+                u128 const lo_hi{ a_lo * b_hi };
+                u128 const cross{ (lo_lo >> 64) + static_cast<u64>(hi_lo) + lo_hi };
+
+                return a_hi * b_hi + (hi_lo >> 64) + (cross >> 64);
+            }
+#endif
+
+            template <s64 N, typename Reduction>
+            constexpr auto mul_mod(s64 const a, s64 const b) noexcept -> s64
+            {
+                if constexpr( fits_narrow<N>() )
+                {
+                    return Reduction::template reduce<N>(static_cast<u64>(a * b));
+                }
+                else
+                {
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+                    return Reduction::template reduce<N>(static_cast<u128>(a) * static_cast<u128>(b));
+#else
+                    // Double-and-add; every intermediate stays below 2N < 2^64.
+                    u64 res{ 0 };
+                    u64 x{ static_cast<u64>(a) };
+                    u64 y{ static_cast<u64>(b) };
+                    u64 const n{ static_cast<u64>(N) };
+
+                    while( y > 0 )
+                    {
+                        if( y & 1 )
+                        {
+                            res += x;
+                            if( res >= n ) res -= n;
+                        }
+
+                        x += x;
+                        if( x >= n ) x -= n;
+                        y >>= 1;
+                    }
+
+                    return static_cast<s64>(res);
+#endif
+                }
+            }
+
+            template <typename T>
+            constexpr auto pow_binary(T const base, T const one, u64 const exponent) noexcept -> T
+            {
+                if( exponent == 0 )
+                {
+                    return one;
+                }
+
+                T res{ base };
+
+                for( auto bit{ std::bit_width(exponent) - 1 }; bit-- > 0; )
+                {
+                    res *= res;
+
+                    if( (exponent >> bit) & 1 )
+                    {
+                        res *= base;
+                    }
+                }
+
+                return res;
+            }
+
+            template <u64 E, typename T>
+            constexpr auto pow_unrolled(T const base, T const one) noexcept -> T
+            {
+                if constexpr( E == 0 )
+                {
+                    return one;
+                }
+                else if constexpr( E == 1 )
+                {
+                    return base;
+                }
+                else
+                {
+                    T const half{ pow_unrolled<E / 2>(base, one) };
+
+                    if constexpr( E % 2 == 0 )
+                    {
+                        return half * half;
+                    }
+                    else
+                    {
+                        return half * half * base;
+                    }
+                }
+            }
+
+            template<s64 N>
+            constexpr auto ipow(s64 const base, s64 const exponent) -> s64
+            {
+                if( exponent < 0 )
+                {
+                    throw std::invalid_argument{ "Exponent must be non-negative." };
+                }
+
+                return pow_binary(int_mod<N>{ base }, int_mod<N>{ 1 }, static_cast<u64>(exponent)).value();
+            }
+
+            constexpr auto gcd_and_inverse(s64 const a, s64 const n) noexcept -> std::pair<s64, s64>
+            {
+                s64 r0{ n };
+                s64 r1{ a };
+                s64 t0{ 0 };
+                s64 t1{ 1 };
+
+                while( r1 != 0 )
+                {
+                    s64 const q{ r0 / r1 };
+
+                    r0 = std::exchange(r1, r0 - q * r1);
+                    t0 = std::exchange(t1, t0 - q * t1);
+                }
+
+                return { r0, t0 < 0 ? t0 + n : t0 };
+            }
+
+            constexpr auto gcd_and_inverse_narrow(u32 const a, u32 const n) noexcept -> std::pair<s64, s64>
+            {
+                u32 r0{ n };
+                u32 r1{ a };
+                s64 t0{ 0 };
+                s64 t1{ 1 };
+
+                while( r1 != 0 )
+                {
+                    u32 const q{ r0 / r1 };
+
+                    r0 = std::exchange(r1, r0 - q * r1);
+                    t0 = std::exchange(t1, t0 - static_cast<s64>(q) * t1);
+                }
+
+                return { r0, t0 < 0 ? t0 + n : t0 };
+            }
+
+            constexpr auto mul_mod(u64 const a, u64 const b, u64 const n) noexcept -> u64
+            {
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+                return static_cast<u64>((static_cast<u128>(a) * b) % n);
+#else
+                u64 res{ 0 };
+                u64 x{ a };
+                u64 y{ b };
+
+                while( y > 0 )
+                {
+                    if( y & 1 )
+                    {
+                        res = (res >= n - x) ? res - (n - x) : res + x;
+                    }
+
+                    x = (x >= n - x) ? x - (n - x) : x + x;
+                    y >>= 1;
+                }
+
+                return res;
+#endif
+            }
+
+            constexpr auto pow_mod(u64 base, u64 exponent, u64 const n) noexcept -> u64
+            {
+                u64 res{ 1 % n };
+                base %= n;
+
+                while( exponent > 0 )
+                {
+                    if( exponent & 1 )
                     {
-                        throw;
+                        res = mul_mod(res, base, n);
                     }
 
+                    base = mul_mod(base, base, n);
+                    exponent >>= 1;
+                }
+
+                return res;
+            }
+
+            constexpr auto is_prime(u64 const n) noexcept -> bool
+            {
+                if( n < 2 )
+                {
+                    return false;
+                }
+
+                for( u64 const p : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 } )
+                {
+                    if( n % p == 0 )
+                    {
+                        return n == p;
+                    }
+                }
+
+                u64 d{ n - 1 };
+                int s{ 0 };
+
+                while( (d & 1) == 0 )
+                {
+                    d >>= 1;
+                    ++s;
+                }
+
+                // These twelve bases are a deterministic witness set for every n < 3.3 * 10^24.
+                for( u64 const a : { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 } )
+                {
+                    u64 x{ pow_mod(a, d, n) };
+
+                    if( x == 1 || x == n - 1 )
+                    {
+                        continue;
+                    }
+
+                    bool composite{ true };
+
+                    for( auto i{ 1 }; i < s; ++i )
+                    {
+                        x = mul_mod(x, x, n);
+
+                        if( x == n - 1 )
+                        {
+                            composite = false;
+                            break;
+                        }
+                    }
+
+                    if( composite )
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <s64 N>
+            constexpr auto prime_inverse_of(s64 const n) noexcept -> s64
+            {
+                if constexpr( N < 256 )
+                {
+                    return pow_unrolled<static_cast<u64>(N - 2)>(int_mod<N>{ n }, int_mod<N>{ 1 }).value();
+                }
+                else if constexpr( N <= std::numeric_limits<u32>::max() )
+                {
+                    return gcd_and_inverse_narrow(static_cast<u32>(n), static_cast<u32>(N)).second;
                 }
                 else
                 {
-                    throw std::invalid_argument(std::to_string(n) + " is not invertible modulo " + std::to_string(N)
-                        + " because gcd(" + std::to_string(n) + ", " + std::to_string(N) + ") = "
-                        + std::to_string(d) + ", which is not 1.\n");
+                    return gcd_and_inverse(n, N).second;
                 }
+            }
+
+            template <s64 N>
+            constexpr auto try_inverse_of(s64 const n) noexcept -> std::optional<s64>
+            {
+                s64 const a{ standard_modulo<N>(n) };
+
+                if constexpr( prime_modulus<N> )
+                {   // Every non-zero residue is a unit.
+                    if( a == 0 )
+                    {
+                        return std::nullopt;
+                    }
+
+                    return prime_inverse_of<N>(a);
+                }
+                else
+                {
+                    std::pair<s64, s64> d_inv;
 
-                return inv;
+                    if constexpr( N <= std::numeric_limits<u32>::max() )
+                    {
+                        d_inv = gcd_and_inverse_narrow(static_cast<u32>(a), static_cast<u32>(N));
+                    }
+                    else
+                    {
+                        d_inv = gcd_and_inverse(a, N);
+                    }
+
+                    auto const [d, inv] = d_inv;
+
+                    if( d != 1 )
+                    {
+                        return std::nullopt;
+                    }
+
+                    return inv;
+                }
+            }
+
+            inline auto throw_not_invertible(s64 const n, s64 const modulus) -> void
+            {
+                throw std::invalid_argument(std::to_string(n) + " is not invertible modulo " + std::to_string(modulus)
+                    + " because gcd(" + std::to_string(n) + ", " + std::to_string(modulus) + ") = "
+                    + std::to_string(gcd(n, modulus)) + ", which is not 1.\n");
             }
 
             template <s64 N>
+            constexpr auto inverse_of(s64 n) -> s64
+            {
+                if( auto const inv = try_inverse_of<N>(n) )
+                {
+                    return *inv;
+                }
+
+                throw_not_invertible(n, N);
+            }
+
+            template <s64 N, typename Reduction>
             constexpr auto standard_modulo(s64 rhs) -> s64
             {
-                rhs %= N;
+                if constexpr( std::is_same_v<Reduction, remainder_reduction> )
+                {
+                    rhs %= N;
+
+                    if( rhs < 0 )
+                    {
+                        rhs += N;
+                    }
+
+                    return rhs;
+                }
+                else
+                {
+                    if( rhs < 0 )
+                    {   // Reduce |rhs| and reflect, taking care that -INT64_MIN is only representable unsigned.
+                        s64 const res{ Reduction::template reduce<N>(u64{ 0 } - static_cast<u64>(rhs)) };
+                        return res == 0 ? 0 : N - res;
+                    }
+
+                    return Reduction::template reduce<N>(static_cast<u64>(rhs));
+                }
+            }
+
+            constexpr auto jacobi_symbol(u64 a, u64 n) noexcept -> int
+            {
+                if( a == 0 )
+                {
+                    return n == 1 ? 1 : 0;
+                }
+
+                // Bit 1 of sign holds the parity of the sign flips. (2/n) = -1 exactly when n is 3 or 5 mod 8,
+                // i.e. when bits 1 and 2 of n differ, so each factor of 2 removed from a flips it by (n ^ n >> 1).
+                int zeros{ std::countr_zero(a) };
+                u64 sign{ (n ^ n >> 1) & static_cast<u64>(zeros) << 1 };
+                a >>= zeros;
+
+                while( a != n )
+                {   // Both are odd. Swap them if a < n, where reciprocity gives (a/n) = -(n/a) exactly when both
+                    // are 3 mod 4, then replace a by a - n. The swap is a mask, as a branch would be unpredictable.
+                    u64 const difference{ a - n };
+                    u64 const swap{ u64{ 0 } - static_cast<u64>(a < n) };
+
+                    sign ^= a & n & swap;
+                    n += difference & swap;
+                    a = (difference ^ swap) - swap;
+
+                    zeros = std::countr_zero(a);
+                    sign ^= (n ^ n >> 1) & static_cast<u64>(zeros) << 1;
+                    a >>= zeros;
+                }
+
+                return n != 1 ? 0 : (sign & 2) != 0 ? -1 : 1;
+            }
+
+            constexpr auto least_non_residue(u64 const n) noexcept -> u64
+            {
+                u64 z{ 2 };
+
+                while( jacobi_symbol(z, n) != -1 )
+                {
+                    ++z;
+                }
+
+                return z;
+            }
+
+            template <s64 N, typename Reduction>
+            constexpr auto sqrt_finish(int_mod<N, Reduction> const a, int_mod<N, Reduction> const w) noexcept
+                -> std::optional<int_mod<N, Reduction>>
+            {
+                using T = int_mod<N, Reduction>;
+                using traits = sqrt_traits<N>;
+
+                if( a == 0 )
+                {
+                    return a;
+                }
+
+                T root;
+
+                if constexpr( N % 4 == 3 )
+                {
+                    root = w;
+                }
+                else if constexpr( N % 8 == 5 )
+                {   // Atkin: with b = (2a)^((N-5)/8) and i = 2ab^2, which is a square root of -1 when a is a residue.
+                    T const b{ w * T{ traits::two_power } };
+                    T const i{ (a + a) * b * b };
+
+                    root = a * b * (i - T{ 1 });
+                }
+                else
+                {   // Tonelli-Shanks: keep r^2 = a t while the order 2^i of t shrinks, until t = 1. Multiplying
+                    // r by g^(2^(s-i-1)) multiplies t by g^(2^(s-i)), of order 2^i too, which lowers the order of t.
+                    T r{ a * w };
+                    T t{ r * w };
+                    int m{ traits::two_adicity };
+
+                    while( t != 1 )
+                    {
+                        int i{ 0 };
+
+                        for( T t2{ t }; t2 != 1; t2 *= t2 )
+                        {
+                            if( ++i == m )
+                            {   // t is not in the subgroup of order 2^(m-1), so a is not a square.
+                                return std::nullopt;
+                            }
+                        }
+
+                        auto const j = static_cast<std::size_t>(traits::two_adicity - i);
+
+                        m = i;
+                        t *= T{ traits::unity_powers[j] };
+                        r *= T{ traits::unity_powers[j - 1] };
+                    }
+
+                    root = r;
+                }
 
-                if( rhs < 0 )
+                if( root * root != a )
                 {
-                    rhs += N;
+                    return std::nullopt;
                 }
 
-                return rhs;
+                return root.value() <= N / 2 ? root : -root;
+            }
+
+            template <typename T, std::size_t L>
+            constexpr auto operator*(lockstep<T, L> lhs, lockstep<T, L> const &rhs) noexcept -> lockstep<T, L>
+            {
+                for( std::size_t k{ 0 }; k < L; ++k )
+                {
+                    lhs.lanes[k] *= rhs.lanes[k];
+                }
+
+                return lhs;
             }
 
         } // namespace impl_details
 
+        // Reduction policy definitions.
+        template <s64 N>
+        constexpr auto remainder_reduction::reduce(u64 x) noexcept -> s64
+        {
+            return static_cast<s64>(x % static_cast<u64>(N));
+        }
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+        template <s64 N>
+        constexpr auto remainder_reduction::reduce(u128 x) noexcept -> s64
+        {
+            return static_cast<s64>(x % static_cast<u128>(N));
+        }
+#endif
+
+        template <s64 N>
+        constexpr auto barrett_reduction::reduce(u64 x) noexcept -> s64
+        {
+            u64 const q{ impl_details::mul_hi(x, impl_details::barrett_factor<N, u64>) };
+            u64 res{ x - q * static_cast<u64>(N) };
+
+            if( res >= static_cast<u64>(N) )
+            {
+                res -= static_cast<u64>(N);
+            }
+
+            return static_cast<s64>(res);
+        }
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+        template <s64 N>
+        constexpr auto barrett_reduction::reduce(u128 x) noexcept -> s64
+        {
+            u128 const q{ impl_details::mul_hi(x, impl_details::barrett_factor<N, u128>) };
+            u128 res{ x - q * static_cast<u128>(N) };
+
+            if( res >= static_cast<u128>(N) )
+            {
+                res -= static_cast<u128>(N);
+            }
+
+            return static_cast<s64>(res);
+        }
+#endif
+
     } // namespace int_mod
 
 } // namespace math_nerd
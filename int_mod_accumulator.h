@@ -0,0 +1,284 @@
+#pragma once
+#ifndef MATH_NERD_INT_MOD_ACCUMULATOR_H
+#define MATH_NERD_INT_MOD_ACCUMULATOR_H
+
+/** \file int_mod_accumulator.h
+    \brief Sums of int_mod<N> products kept in unreduced 64- or 128-bit integers and reduced only when they could overflow.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "int_mod.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        namespace impl_details
+        {
+            /** \struct lazy_sum_traits<N>
+                \brief How many products of residues modulo N an unsigned accumulator can absorb between reductions.
+                \details A 64-bit accumulator is used when it can take at least 8 products, otherwise a 128-bit one if
+                         available. chunk leaves room for one residue carried over from the previous reduction.
+                         If neither accumulator can hold a product, chunk is 0 and callers reduce every product.
+             */
+            template <s64 N>
+            struct lazy_sum_traits
+            {
+                /** \property static constexpr bool narrow
+                    \brief True if \f$(N-1)^2\f$ fits in 64 bits.
+                 */
+                static constexpr bool narrow{ static_cast<u64>(N - 1) <= std::numeric_limits<u64>::max() / static_cast<u64>(N - 1) };
+
+                /** \property static constexpr u64 narrow_chunk
+                    \brief Products a 64-bit accumulator can take, or 0 if not even one fits.
+                 */
+                static constexpr u64 narrow_chunk{ narrow ? (std::numeric_limits<u64>::max() - static_cast<u64>(N - 1))
+                                                              / (static_cast<u64>(N - 1) * static_cast<u64>(N - 1))
+                                                          : 0 };
+
+#if defined(MATH_NERD_INT_MOD_HAS_INT128)
+                /** \property static constexpr bool use_narrow
+                    \brief True if the 64-bit accumulator is used.
+                 */
+                static constexpr bool use_narrow{ narrow_chunk >= 8 };
+
+                /** \typedef type
+                    \brief The accumulator type.
+                 */
+                using type = std::conditional_t<use_narrow, u64, u128>;
+
+                /** \property static constexpr u64 chunk
+                    \brief Products that may be added to a value below N before the accumulator has to be reduced.
+                 */
+                static constexpr u64 chunk{ use_narrow ? narrow_chunk
+                    : static_cast<u64>(std::min<u128>((~u128{ 0 } - static_cast<u128>(N - 1))
+                                                      / (static_cast<u128>(N - 1) * static_cast<u128>(N - 1)),
+                                                      std::numeric_limits<u64>::max())) };
+#else
+                static constexpr bool use_narrow{ true };
+                using type = u64;
+                static constexpr u64 chunk{ narrow_chunk };
+#endif
+            };
+
+        } // namespace impl_details
+
+        /** \class int_mod_accumulator<N, Reduction>
+            \brief Running sum of residues and products of residues modulo N that reduces only every capacity terms.
+            \details Each int_mod<N> operator+= pays a division. The accumulator instead adds plain integers into
+                     lazy_sum_traits<N>::type, and tracks how many terms it holds. It reduces when capacity is reached,
+                     which is computed at compile time so the sum can never overflow. If no accumulator can hold even
+                     one product (N above \f$2^{32}\f$ without 128-bit integers), every term is reduced.
+         */
+        template <s64 N, typename Reduction = remainder_reduction>
+        class int_mod_accumulator
+        {
+        public:
+            /** \typedef value_type
+                \brief The residue type summed.
+             */
+            using value_type = int_mod<N, Reduction>;
+
+            /** \typedef sum_type
+                \brief The unreduced integer type.
+             */
+            using sum_type = typename impl_details::lazy_sum_traits<N>::type;
+
+            /** \property static constexpr u64 capacity
+                \brief Terms that can be added after a reduction before the next one is due. 0 means every term is reduced.
+             */
+            static constexpr u64 capacity{ impl_details::lazy_sum_traits<N>::chunk };
+
+        private:
+            /** \property sum_type sum_
+                \brief Unreduced sum, congruent to the value modulo N.
+             */
+            sum_type sum_{ 0 };
+
+            /** \property u64 terms_
+                \brief Terms added since the last reduction.
+             */
+            u64 terms_{ 0 };
+
+            /** \fn constexpr auto make_room() noexcept -> void
+                \brief Reduces the sum if it has no room for another term.
+             */
+            constexpr auto make_room() noexcept -> void;
+
+        public:
+            /** \fn constexpr int_mod_accumulator()
+                \brief Starts at zero.
+             */
+            constexpr int_mod_accumulator() = default;
+
+            /** \fn constexpr explicit int_mod_accumulator(int_mod<N> const start) noexcept
+                \brief Starts at start.
+             */
+            constexpr explicit int_mod_accumulator(value_type const start) noexcept;
+
+            /** \fn constexpr auto add_product(int_mod<N> const a, int_mod<N> const b) noexcept -> int_mod_accumulator<N> &
+                \brief Adds a b.
+             */
+            constexpr auto add_product(value_type const a, value_type const b) noexcept -> int_mod_accumulator &;
+
+            /** \fn auto add_products(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b) -> int_mod_accumulator<N> &
+                \brief Adds the dot product of a and b. Throws std::invalid_argument if the spans differ in length.
+                \details Runs in capacity-sized runs without a bounds check inside, which lets the compiler vectorise.
+             */
+            auto add_products(std::span<value_type const> const a, std::span<value_type const> const b) -> int_mod_accumulator &;
+
+            /** \fn constexpr auto operator+=(int_mod<N> const rhs) noexcept -> int_mod_accumulator<N> &
+                \brief Adds a residue, which takes one term like a product does.
+             */
+            constexpr auto operator+=(value_type const rhs) noexcept -> int_mod_accumulator &;
+
+            /** \fn constexpr auto value() const noexcept -> int_mod<N>
+                \brief Returns the sum reduced modulo N.
+             */
+            constexpr auto value() const noexcept -> value_type;
+
+            /** \fn constexpr auto reset() noexcept -> void
+                \brief Sets the sum back to zero.
+             */
+            constexpr auto reset() noexcept -> void
+            {
+                sum_ = 0;
+                terms_ = 0;
+            }
+        };
+
+        /** \fn auto dot(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b) -> int_mod<N>
+            \brief Returns the dot product of a and b using int_mod_accumulator. Throws std::invalid_argument if the
+                   spans differ in length.
+         */
+        template <s64 N, typename Reduction>
+        auto dot(std::span<int_mod<N, Reduction> const> const a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> const b)
+            -> int_mod<N, Reduction>;
+
+        template <s64 N, typename Reduction>
+        constexpr int_mod_accumulator<N, Reduction>::int_mod_accumulator(value_type const start) noexcept
+            : sum_{ static_cast<sum_type>(start.value()) }, terms_{ 1 }
+        {
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod_accumulator<N, Reduction>::make_room() noexcept -> void
+        {
+            if( terms_ >= capacity )
+            {
+                sum_ = static_cast<sum_type>(Reduction::template reduce<N>(sum_));
+                terms_ = 0;
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod_accumulator<N, Reduction>::add_product(value_type const a, value_type const b) noexcept -> int_mod_accumulator &
+        {
+            if constexpr( capacity == 0 )
+            {
+                sum_ = static_cast<sum_type>((value_type{ static_cast<s64>(sum_) } + a * b).value());
+            }
+            else
+            {
+                make_room();
+                sum_ += static_cast<sum_type>(a.value()) * static_cast<sum_type>(b.value());
+                ++terms_;
+            }
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto int_mod_accumulator<N, Reduction>::add_products(std::span<value_type const> const a, std::span<value_type const> const b)
+            -> int_mod_accumulator &
+        {
+            if( a.size() != b.size() )
+            {
+                throw std::invalid_argument("Dot product spans have different lengths (" + std::to_string(a.size())
+                    + " and " + std::to_string(b.size()) + ").\n");
+            }
+
+            if constexpr( capacity == 0 )
+            {
+                for( std::size_t i{ 0 }; i < a.size(); ++i )
+                {
+                    add_product(a[i], b[i]);
+                }
+            }
+            else
+            {
+                for( std::size_t i{ 0 }; i < a.size(); )
+                {
+                    make_room();
+
+                    std::size_t const run{ static_cast<std::size_t>(std::min<u64>(capacity - terms_, a.size() - i)) };
+                    sum_type sum{ sum_ };
+
+                    for( std::size_t j{ i }; j < i + run; ++j )
+                    {
+                        sum += static_cast<sum_type>(a[j].value()) * static_cast<sum_type>(b[j].value());
+                    }
+
+                    sum_ = sum;
+                    terms_ += run;
+                    i += run;
+                }
+            }
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod_accumulator<N, Reduction>::operator+=(value_type const rhs) noexcept -> int_mod_accumulator &
+        {
+            if constexpr( capacity == 0 )
+            {
+                sum_ = static_cast<sum_type>((value_type{ static_cast<s64>(sum_) } + rhs).value());
+            }
+            else
+            {   // A residue is at most (N - 1)^2, so it fits wherever a product does.
+                make_room();
+                sum_ += static_cast<sum_type>(rhs.value());
+                ++terms_;
+            }
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        constexpr auto int_mod_accumulator<N, Reduction>::value() const noexcept -> value_type
+        {
+            if constexpr( capacity == 0 )
+            {
+                return value_type{ static_cast<s64>(sum_) };
+            }
+            else
+            {
+                return value_type{ Reduction::template reduce<N>(sum_) };
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto dot(std::span<int_mod<N, Reduction> const> const a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> const b)
+            -> int_mod<N, Reduction>
+        {
+            return int_mod_accumulator<N, Reduction>{ }.add_products(a, b).value();
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
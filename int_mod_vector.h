@@ -0,0 +1,640 @@
+#pragma once
+#ifndef MATH_NERD_INT_MOD_VECTOR_H
+#define MATH_NERD_INT_MOD_VECTOR_H
+
+/** \file int_mod_vector.h
+    \brief Element-wise kernels over spans of int_mod<N> with AVX2/AVX-512 paths and runtime CPU dispatch.
+ */
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "int_mod.h"
+#include "montgomery_int_mod.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+/** \def MATH_NERD_INT_MOD_X86_DISPATCH
+    \brief Defined when AVX2/AVX-512 kernels can be compiled with per-function target attributes.
+ */
+#define MATH_NERD_INT_MOD_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \enum simd_level
+            \brief Instruction set used by the vector kernels.
+         */
+        enum class simd_level
+        {
+            scalar, ///< Plain int_mod<N> operators.
+            avx2,   ///< 4 lanes of 64 bits.
+            avx512  ///< 8 lanes of 64 bits.
+        };
+
+        /** \fn auto detected_simd_level() noexcept -> simd_level
+            \brief Returns the best instruction set supported by the running CPU. Detected once and cached.
+         */
+        auto detected_simd_level() noexcept -> simd_level;
+
+        /** \fn auto vector_add(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b, std::span<int_mod<N>> out, simd_level level) -> void
+            \brief Sets out[i] = a[i] + b[i]. Throws std::invalid_argument if the spans differ in length.
+            \details Every kernel accepts out aliasing an input exactly, and gives the same result as the int_mod<N>
+                     operators at every simd_level. level defaults to detected_simd_level(); requesting a level the CPU
+                     does not support is undefined behaviour.
+         */
+        template <s64 N, typename Reduction>
+        auto vector_add(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_sub(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b, std::span<int_mod<N>> out, simd_level level) -> void
+            \brief Sets out[i] = a[i] - b[i]. Throws std::invalid_argument if the spans differ in length.
+         */
+        template <s64 N, typename Reduction>
+        auto vector_sub(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_mul(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b, std::span<int_mod<N>> out, simd_level level) -> void
+            \brief Sets out[i] = a[i] * b[i]. Throws std::invalid_argument if the spans differ in length.
+            \details The vector path needs an odd \f$N < 2^{31}\f$ and reduces with two 32-bit Montgomery steps, the second
+                     multiplying by \f$R^2\f$ so the result comes out in standard form. Other moduli use the scalar path.
+         */
+        template <s64 N, typename Reduction>
+        auto vector_mul(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_fma(std::span<int_mod<N> const> a, std::span<int_mod<N> const> b, std::span<int_mod<N> const> c, std::span<int_mod<N>> out, simd_level level) -> void
+            \brief Sets out[i] = a[i] * b[i] + c[i]. Throws std::invalid_argument if the spans differ in length.
+         */
+        template <s64 N, typename Reduction>
+        auto vector_fma(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::type_identity_t<std::span<int_mod<N, Reduction> const>> c, std::span<int_mod<N, Reduction>> out,
+                        simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_scale(std::span<int_mod<N> const> a, int_mod<N> s, std::span<int_mod<N>> out, simd_level level) -> void
+            \brief Sets out[i] = a[i] * s. Throws std::invalid_argument if the spans differ in length.
+         */
+        template <s64 N, typename Reduction>
+        auto vector_scale(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<int_mod<N, Reduction>> s,
+                          std::span<int_mod<N, Reduction>> out, simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_jacobi(std::span<int_mod<N> const> a, std::span<int> out, simd_level level) -> void
+            \brief Sets out[i] = jacobi(a[i]). Throws std::invalid_argument if the spans differ in length.
+            \details The vector path needs an odd \f$N < 2^{31}\f$ and runs the binary Jacobi algorithm on 8 or 16 residues
+                     in 32-bit lanes at once, removing one factor of 2 per step and masking off lanes which have finished.
+                     Other moduli use the scalar jacobi().
+         */
+        template <s64 N, typename Reduction>
+        auto vector_jacobi(std::span<int_mod<N, Reduction> const> a, std::span<int> out,
+                           simd_level level = detected_simd_level()) -> void;
+
+        /** \fn auto vector_jacobi(R const &a, std::span<int> out, simd_level level) -> void
+            \brief vector_jacobi() over a contiguous container of int_mod<N>, such as a std::vector.
+         */
+        template <impl_details::int_mod_range R>
+        auto vector_jacobi(R const &a, std::span<int> out, simd_level level = detected_simd_level()) -> void
+        {
+            vector_jacobi(std::span<std::ranges::range_value_t<R> const>{ a }, out, level);
+        }
+
+        namespace impl_details
+        {
+            /** \enum vector_op
+                \brief Element-wise operation performed by a kernel.
+             */
+            enum class vector_op
+            {
+                add,
+                sub,
+                mul,
+                fma,
+                scale
+            };
+
+            /** \fn constexpr auto vector_mul_supported() noexcept -> bool
+                \brief True if the vector multiplication path applies to modulus N.
+             */
+            template <s64 N>
+            constexpr auto vector_mul_supported() noexcept -> bool
+            {
+                return N % 2 == 1 && N < (s64{ 1 } << 31);
+            }
+
+            /** \fn auto vector_kernel_scalar(int_mod<N> const *a, int_mod<N> const *b, int_mod<N> const *c, int_mod<N> *out, std::size_t first, std::size_t const last) -> void
+                \brief Scalar kernel over [first, last) using the int_mod<N> operators. For scale, *b is the scalar.
+             */
+            template <vector_op Op, s64 N, typename Reduction>
+            auto vector_kernel_scalar(int_mod<N, Reduction> const *a, int_mod<N, Reduction> const *b, int_mod<N, Reduction> const *c,
+                                      int_mod<N, Reduction> *out, std::size_t first, std::size_t const last) -> void
+            {
+                if constexpr( Op == vector_op::scale )
+                {   // Every element is multiplied by the same scalar.
+                    fixed_multiplier<N, Reduction> const scalar{ *b };
+
+                    for( ; first < last; ++first )
+                    {
+                        out[first] = a[first] * scalar;
+                    }
+
+                    return;
+                }
+
+                for( ; first < last; ++first )
+                {
+                    if constexpr( Op == vector_op::add )
+                    {
+                        out[first] = a[first] + b[first];
+                    }
+                    else if constexpr( Op == vector_op::sub )
+                    {
+                        out[first] = a[first] - b[first];
+                    }
+                    else if constexpr( Op == vector_op::mul )
+                    {
+                        out[first] = a[first] * b[first];
+                    }
+                    else
+                    {
+                        out[first] = a[first] * b[first] + c[first];
+                    }
+                }
+            }
+
+#if defined(MATH_NERD_INT_MOD_X86_DISPATCH)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+// GCC 12's own AVX-512 intrinsics trip this warning through _mm512_undefined_epi32().
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+            /** \struct avx2_ops
+                \brief Modular arithmetic on 4 residues modulo N held in the 64-bit lanes of a __m256i.
+                \details Lambdas do not inherit target attributes, so the lane operations are static members instead.
+             */
+            template <s64 N>
+            struct avx2_ops
+            {
+                using params = montgomery_params<(vector_mul_supported<N>() ? N : 3)>;
+
+                /** \fn static auto load(s64 const *p) -> __m256i
+                    \brief Unaligned load of 4 residues.
+                 */
+                __attribute__((target("avx2")))
+                static auto load(s64 const *p) -> __m256i
+                {
+                    return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+                }
+
+                /** \fn static auto add(__m256i const x, __m256i const y) -> __m256i
+                    \brief x - (N - y), corrected if negative, exactly as int_mod<N>::operator+=.
+                 */
+                __attribute__((target("avx2")))
+                static auto add(__m256i const x, __m256i const y) -> __m256i
+                {
+                    __m256i const n{ _mm256_set1_epi64x(N) };
+                    __m256i const s{ _mm256_sub_epi64(x, _mm256_sub_epi64(n, y)) };
+                    return _mm256_add_epi64(s, _mm256_and_si256(n, _mm256_cmpgt_epi64(_mm256_setzero_si256(), s)));
+                }
+
+                /** \fn static auto sub(__m256i const x, __m256i const y) -> __m256i
+                    \brief x - y, corrected if negative.
+                 */
+                __attribute__((target("avx2")))
+                static auto sub(__m256i const x, __m256i const y) -> __m256i
+                {
+                    __m256i const n{ _mm256_set1_epi64x(N) };
+                    __m256i const d{ _mm256_sub_epi64(x, y) };
+                    return _mm256_add_epi64(d, _mm256_and_si256(n, _mm256_cmpgt_epi64(_mm256_setzero_si256(), d)));
+                }
+
+                /** \fn static auto reduce(__m256i const t) -> __m256i
+                    \brief REDC with R = 2^32 in each lane. t < N * 2^32 keeps t + mN below 2^64.
+                 */
+                __attribute__((target("avx2")))
+                static auto reduce(__m256i const t) -> __m256i
+                {
+                    __m256i const n{ _mm256_set1_epi64x(N) };
+                    __m256i const m{ _mm256_mul_epu32(t, _mm256_set1_epi64x(params::n_prime)) };
+                    __m256i const r{ _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(m, n)), 32) };
+                    __m256i const rn{ _mm256_sub_epi64(r, n) };
+                    return _mm256_blendv_epi8(rn, r, _mm256_cmpgt_epi64(_mm256_setzero_si256(), rn));
+                }
+
+                /** \fn static auto mul(__m256i const x, __m256i const y) -> __m256i
+                    \brief x * y in standard form: the second REDC multiplies by R^2 to cancel the first one's R^-1.
+                 */
+                __attribute__((target("avx2")))
+                static auto mul(__m256i const x, __m256i const y) -> __m256i
+                {
+                    return reduce(_mm256_mul_epu32(reduce(_mm256_mul_epu32(x, y)), _mm256_set1_epi64x(params::r2)));
+                }
+            };
+
+            /** \struct avx512_ops
+                \brief Modular arithmetic on 8 residues modulo N held in the 64-bit lanes of a __m512i.
+             */
+            template <s64 N>
+            struct avx512_ops
+            {
+                using params = montgomery_params<(vector_mul_supported<N>() ? N : 3)>;
+
+                /** \fn static auto add(__m512i const x, __m512i const y) -> __m512i
+                    \brief x - (N - y), corrected if negative, exactly as int_mod<N>::operator+=.
+                 */
+                __attribute__((target("avx512f")))
+                static auto add(__m512i const x, __m512i const y) -> __m512i
+                {
+                    __m512i const n{ _mm512_set1_epi64(N) };
+                    __m512i const s{ _mm512_sub_epi64(x, _mm512_sub_epi64(n, y)) };
+                    return _mm512_mask_add_epi64(s, _mm512_cmplt_epi64_mask(s, _mm512_setzero_si512()), s, n);
+                }
+
+                /** \fn static auto sub(__m512i const x, __m512i const y) -> __m512i
+                    \brief x - y, corrected if negative.
+                 */
+                __attribute__((target("avx512f")))
+                static auto sub(__m512i const x, __m512i const y) -> __m512i
+                {
+                    __m512i const d{ _mm512_sub_epi64(x, y) };
+                    return _mm512_mask_add_epi64(d, _mm512_cmplt_epi64_mask(d, _mm512_setzero_si512()), d, _mm512_set1_epi64(N));
+                }
+
+                /** \fn static auto reduce(__m512i const t) -> __m512i
+                    \brief REDC with R = 2^32 in each lane. r < 2N, and r - N wraps around to a huge value exactly when r < N.
+                 */
+                __attribute__((target("avx512f")))
+                static auto reduce(__m512i const t) -> __m512i
+                {
+                    __m512i const n{ _mm512_set1_epi64(N) };
+                    __m512i const m{ _mm512_mul_epu32(t, _mm512_set1_epi64(params::n_prime)) };
+                    __m512i const r{ _mm512_srli_epi64(_mm512_add_epi64(t, _mm512_mul_epu32(m, n)), 32) };
+                    return _mm512_min_epu64(r, _mm512_sub_epi64(r, n));
+                }
+
+                /** \fn static auto mul(__m512i const x, __m512i const y) -> __m512i
+                    \brief x * y in standard form.
+                 */
+                __attribute__((target("avx512f")))
+                static auto mul(__m512i const x, __m512i const y) -> __m512i
+                {
+                    return reduce(_mm512_mul_epu32(reduce(_mm512_mul_epu32(x, y)), _mm512_set1_epi64(params::r2)));
+                }
+            };
+
+            /** \fn auto vector_kernel_avx2(s64 const *a, s64 const *b, s64 const *c, s64 *out, std::size_t const size) -> std::size_t
+                \brief AVX2 kernel over whole blocks of 4 residues. Returns the number of elements processed.
+             */
+            template <vector_op Op, s64 N>
+            __attribute__((target("avx2")))
+            auto vector_kernel_avx2(s64 const *a, s64 const *b, s64 const *c, s64 *out, std::size_t const size) -> std::size_t
+            {
+                using ops = avx2_ops<N>;
+
+                std::size_t i{ 0 };
+                __m256i const s{ _mm256_set1_epi64x(Op == vector_op::scale ? *b : 0) };
+
+                for( ; i + 4 <= size; i += 4 )
+                {
+                    __m256i const x{ ops::load(a + i) };
+                    __m256i res;
+
+                    if constexpr( Op == vector_op::add )
+                    {
+                        res = ops::add(x, ops::load(b + i));
+                    }
+                    else if constexpr( Op == vector_op::sub )
+                    {
+                        res = ops::sub(x, ops::load(b + i));
+                    }
+                    else if constexpr( Op == vector_op::mul )
+                    {
+                        res = ops::mul(x, ops::load(b + i));
+                    }
+                    else if constexpr( Op == vector_op::fma )
+                    {
+                        res = ops::add(ops::mul(x, ops::load(b + i)), ops::load(c + i));
+                    }
+                    else
+                    {
+                        res = ops::mul(x, s);
+                    }
+
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), res);
+                }
+
+                return i;
+            }
+
+            /** \fn auto vector_kernel_avx512(s64 const *a, s64 const *b, s64 const *c, s64 *out, std::size_t const size) -> std::size_t
+                \brief AVX-512 kernel over whole blocks of 8 residues. Returns the number of elements processed.
+             */
+            template <vector_op Op, s64 N>
+            __attribute__((target("avx512f")))
+            auto vector_kernel_avx512(s64 const *a, s64 const *b, s64 const *c, s64 *out, std::size_t const size) -> std::size_t
+            {
+                using ops = avx512_ops<N>;
+
+                std::size_t i{ 0 };
+                __m512i const s{ _mm512_set1_epi64(Op == vector_op::scale ? *b : 0) };
+
+                for( ; i + 8 <= size; i += 8 )
+                {
+                    __m512i const x{ _mm512_loadu_si512(a + i) };
+                    __m512i res;
+
+                    if constexpr( Op == vector_op::add )
+                    {
+                        res = ops::add(x, _mm512_loadu_si512(b + i));
+                    }
+                    else if constexpr( Op == vector_op::sub )
+                    {
+                        res = ops::sub(x, _mm512_loadu_si512(b + i));
+                    }
+                    else if constexpr( Op == vector_op::mul )
+                    {
+                        res = ops::mul(x, _mm512_loadu_si512(b + i));
+                    }
+                    else if constexpr( Op == vector_op::fma )
+                    {
+                        res = ops::add(ops::mul(x, _mm512_loadu_si512(b + i)), _mm512_loadu_si512(c + i));
+                    }
+                    else
+                    {
+                        res = ops::mul(x, s);
+                    }
+
+                    _mm512_storeu_si512(out + i, res);
+                }
+
+                return i;
+            }
+
+            /** \fn auto jacobi_kernel_avx2(s64 const *a, int *out, std::size_t const size) -> std::size_t
+                \brief AVX2 binary Jacobi over whole blocks of 8 residues below \f$2^{31}\f$. Returns the number of elements processed.
+                \details Bit 1 of each lane of t holds the parity of its sign flips, as in impl_details::jacobi_symbol().
+             */
+            template <s64 N>
+            __attribute__((target("avx2")))
+            auto jacobi_kernel_avx2(s64 const *a, int *out, std::size_t const size) -> std::size_t
+            {
+                __m256i const one{ _mm256_set1_epi32(1) };
+                __m256i const two{ _mm256_set1_epi32(2) };
+                __m256i const zero{ _mm256_setzero_si256() };
+                __m256i const low_halves{ _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7) };
+
+                std::size_t i{ 0 };
+
+                for( ; i + 8 <= size; i += 8 )
+                {
+                    __m256i const lo{ _mm256_permutevar8x32_epi32(avx2_ops<N>::load(a + i), low_halves) };
+                    __m256i const hi{ _mm256_permutevar8x32_epi32(avx2_ops<N>::load(a + i + 4), low_halves) };
+
+                    __m256i x{ _mm256_permute2x128_si256(lo, hi, 0x20) };
+                    __m256i n{ _mm256_set1_epi32(static_cast<int>(N)) };
+                    __m256i t{ zero };
+
+                    while( !_mm256_testz_si256(x, x) )
+                    {   // Odd lanes swap so that x >= n, then subtract n. Every nonzero lane then halves x.
+                        __m256i const odd{ _mm256_cmpeq_epi32(_mm256_and_si256(x, one), one) };
+                        __m256i const swap{ _mm256_and_si256(odd, _mm256_cmpgt_epi32(n, x)) };
+
+                        t = _mm256_xor_si256(t, _mm256_and_si256(swap, _mm256_and_si256(x, n)));
+
+                        __m256i const big{ _mm256_blendv_epi8(x, n, swap) };
+                        n = _mm256_blendv_epi8(n, x, swap);
+                        x = _mm256_sub_epi32(big, _mm256_and_si256(odd, n));
+
+                        __m256i const nonzero{ _mm256_xor_si256(_mm256_cmpeq_epi32(x, zero), _mm256_set1_epi32(-1)) };
+                        t = _mm256_xor_si256(t, _mm256_and_si256(nonzero, _mm256_and_si256(_mm256_xor_si256(n, _mm256_srli_epi32(n, 1)), two)));
+                        x = _mm256_srli_epi32(x, 1);
+                    }
+
+                    __m256i const sign{ _mm256_sub_epi32(one, _mm256_and_si256(t, two)) };
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_and_si256(_mm256_cmpeq_epi32(n, one), sign));
+                }
+
+                return i;
+            }
+
+            /** \fn auto jacobi_kernel_avx512(s64 const *a, int *out, std::size_t const size) -> std::size_t
+                \brief AVX-512 binary Jacobi over whole blocks of 16 residues below \f$2^{31}\f$. Returns the number of elements processed.
+             */
+            template <s64 N>
+            __attribute__((target("avx512f")))
+            auto jacobi_kernel_avx512(s64 const *a, int *out, std::size_t const size) -> std::size_t
+            {
+                __m512i const one{ _mm512_set1_epi32(1) };
+                __m512i const two{ _mm512_set1_epi32(2) };
+
+                std::size_t i{ 0 };
+
+                for( ; i + 16 <= size; i += 16 )
+                {
+                    __m256i const lo{ _mm512_cvtepi64_epi32(_mm512_loadu_si512(a + i)) };
+                    __m256i const hi{ _mm512_cvtepi64_epi32(_mm512_loadu_si512(a + i + 8)) };
+
+                    __m512i x{ _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1) };
+                    __m512i n{ _mm512_set1_epi32(static_cast<int>(N)) };
+                    __m512i t{ _mm512_setzero_si512() };
+
+                    while( _mm512_test_epi32_mask(x, x) != 0 )
+                    {
+                        __mmask16 const odd{ _mm512_test_epi32_mask(x, one) };
+                        __mmask16 const swap{ _mm512_mask_cmpgt_epi32_mask(odd, n, x) };
+
+                        t = _mm512_mask_xor_epi32(t, swap, t, _mm512_and_si512(x, n));
+
+                        __m512i const big{ _mm512_mask_blend_epi32(swap, x, n) };
+                        n = _mm512_mask_blend_epi32(swap, n, x);
+                        x = _mm512_mask_sub_epi32(big, odd, big, n);
+
+                        t = _mm512_mask_xor_epi32(t, _mm512_test_epi32_mask(x, x), t, _mm512_and_si512(_mm512_xor_si512(n, _mm512_srli_epi32(n, 1)), two));
+                        x = _mm512_srli_epi32(x, 1);
+                    }
+
+                    __m512i const sign{ _mm512_sub_epi32(one, _mm512_and_si512(t, two)) };
+                    _mm512_storeu_si512(out + i, _mm512_maskz_mov_epi32(_mm512_cmpeq_epi32_mask(n, one), sign));
+                }
+
+                return i;
+            }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+            /** \fn auto vector_dispatch(int_mod<N> const *a, int_mod<N> const *b, int_mod<N> const *c, int_mod<N> *out, std::size_t const size, simd_level const level) -> void
+                \brief Runs the widest applicable kernel, then finishes the tail with the scalar kernel.
+             */
+            template <vector_op Op, s64 N, typename Reduction>
+            auto vector_dispatch(int_mod<N, Reduction> const *a, int_mod<N, Reduction> const *b, int_mod<N, Reduction> const *c,
+                                 int_mod<N, Reduction> *out, std::size_t const size, simd_level const level) -> void
+            {
+                static_assert(sizeof(int_mod<N, Reduction>) == sizeof(s64) && std::is_standard_layout_v<int_mod<N, Reduction>>,
+                              "The vector kernels read int_mod<N> arrays as arrays of their residues.");
+
+                std::size_t done{ 0 };
+
+#if defined(MATH_NERD_INT_MOD_X86_DISPATCH)
+                constexpr bool needs_mul{ Op == vector_op::mul || Op == vector_op::fma || Op == vector_op::scale };
+
+                if constexpr( !needs_mul || vector_mul_supported<N>() )
+                {
+                    auto const raw = [](int_mod<N, Reduction> const *p) { return reinterpret_cast<s64 const *>(p); };
+
+                    if( level == simd_level::avx512 )
+                    {
+                        done = vector_kernel_avx512<Op, N>(raw(a), raw(b), raw(c), reinterpret_cast<s64 *>(out), size);
+                    }
+                    else if( level == simd_level::avx2 )
+                    {
+                        done = vector_kernel_avx2<Op, N>(raw(a), raw(b), raw(c), reinterpret_cast<s64 *>(out), size);
+                    }
+                }
+#else
+                static_cast<void>(level);
+#endif
+
+                vector_kernel_scalar<Op>(a, b, c, out, done, size);
+            }
+
+            /** \fn auto check_vector_sizes(std::size_t const expected, std::size_t const actual) -> void
+                \brief Throws std::invalid_argument if a span passed to a vector kernel has the wrong length.
+             */
+            inline auto check_vector_sizes(std::size_t const expected, std::size_t const actual) -> void
+            {
+                if( expected != actual )
+                {
+                    throw std::invalid_argument("Vector kernel spans have different lengths (" + std::to_string(expected)
+                        + " and " + std::to_string(actual) + ").\n");
+                }
+            }
+
+        } // namespace impl_details
+
+        inline auto detected_simd_level() noexcept -> simd_level
+        {
+#if defined(MATH_NERD_INT_MOD_X86_DISPATCH)
+            static simd_level const level = []
+            {
+                __builtin_cpu_init();
+
+                if( __builtin_cpu_supports("avx512f") )
+                {
+                    return simd_level::avx512;
+                }
+
+                if( __builtin_cpu_supports("avx2") )
+                {
+                    return simd_level::avx2;
+                }
+
+                return simd_level::scalar;
+            }();
+
+            return level;
+#else
+            return simd_level::scalar;
+#endif
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_add(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level) -> void
+        {
+            impl_details::check_vector_sizes(out.size(), a.size());
+            impl_details::check_vector_sizes(out.size(), b.size());
+
+            impl_details::vector_dispatch<impl_details::vector_op::add, N, Reduction>(a.data(), b.data(), nullptr, out.data(), out.size(), level);
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_sub(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level) -> void
+        {
+            impl_details::check_vector_sizes(out.size(), a.size());
+            impl_details::check_vector_sizes(out.size(), b.size());
+
+            impl_details::vector_dispatch<impl_details::vector_op::sub, N, Reduction>(a.data(), b.data(), nullptr, out.data(), out.size(), level);
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_mul(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::span<int_mod<N, Reduction>> out, simd_level level) -> void
+        {
+            impl_details::check_vector_sizes(out.size(), a.size());
+            impl_details::check_vector_sizes(out.size(), b.size());
+
+            impl_details::vector_dispatch<impl_details::vector_op::mul, N, Reduction>(a.data(), b.data(), nullptr, out.data(), out.size(), level);
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_fma(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<std::span<int_mod<N, Reduction> const>> b,
+                        std::type_identity_t<std::span<int_mod<N, Reduction> const>> c, std::span<int_mod<N, Reduction>> out,
+                        simd_level level) -> void
+        {
+            impl_details::check_vector_sizes(out.size(), a.size());
+            impl_details::check_vector_sizes(out.size(), b.size());
+            impl_details::check_vector_sizes(out.size(), c.size());
+
+            impl_details::vector_dispatch<impl_details::vector_op::fma, N, Reduction>(a.data(), b.data(), c.data(), out.data(), out.size(), level);
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_scale(std::type_identity_t<std::span<int_mod<N, Reduction> const>> a, std::type_identity_t<int_mod<N, Reduction>> s,
+                          std::span<int_mod<N, Reduction>> out, simd_level level) -> void
+        {
+            impl_details::check_vector_sizes(out.size(), a.size());
+
+            impl_details::vector_dispatch<impl_details::vector_op::scale, N, Reduction>(a.data(), &s, nullptr, out.data(), out.size(), level);
+        }
+
+        template <s64 N, typename Reduction>
+        auto vector_jacobi(std::span<int_mod<N, Reduction> const> a, std::span<int> out, simd_level level) -> void
+        {
+            static_assert(sizeof(int_mod<N, Reduction>) == sizeof(s64) && std::is_standard_layout_v<int_mod<N, Reduction>>,
+                          "The vector kernels read int_mod<N> arrays as arrays of their residues.");
+
+            impl_details::check_vector_sizes(out.size(), a.size());
+
+            std::size_t i{ 0 };
+
+#if defined(MATH_NERD_INT_MOD_X86_DISPATCH)
+            if constexpr( impl_details::vector_mul_supported<N>() && sizeof(int) == sizeof(u32) )
+            {   // The lanes hold 32 bits, which is enough for an odd N below 2^31.
+                auto const raw = reinterpret_cast<s64 const *>(a.data());
+
+                if( level == simd_level::avx512 )
+                {
+                    i = impl_details::jacobi_kernel_avx512<N>(raw, out.data(), out.size());
+                }
+                else if( level == simd_level::avx2 )
+                {
+                    i = impl_details::jacobi_kernel_avx2<N>(raw, out.data(), out.size());
+                }
+            }
+#else
+            static_cast<void>(level);
+#endif
+
+            for( ; i < out.size(); ++i )
+            {
+                out[i] = jacobi(a[i]);
+            }
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -0,0 +1,1199 @@
+#pragma once
+#ifndef MATH_NERD_MATRIX_H
+#define MATH_NERD_MATRIX_H
+
+/** \file matrix.h
+    \brief Dense row-major matrices over int_mod<N> with a cache-blocked, lazily reduced, multithreaded product, and
+           blocked elimination for determinant, rank and inverse that also works for composite N.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+#include "int_mod_accumulator.h"
+#include "int_mod_vector.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \class matrix<T>
+            \brief Matrix with entries of type T. Only matrix<int_mod<N, Reduction>> is defined.
+         */
+        template <typename T>
+        class matrix;
+
+        namespace impl_details
+        {
+            /** \enum gemm_mode
+                \brief Whether gemm() overwrites its output, or adds the product to it or subtracts it.
+             */
+            enum class gemm_mode
+            {
+                assign,  ///< c = a b
+                add,     ///< c = c + a b
+                subtract ///< c = c - a b
+            };
+
+            /** \fn auto gemm(int_mod<N> const *a, std::size_t const lda, int_mod<N> const *b, std::size_t const ldb, int_mod<N> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n, gemm_mode const mode, unsigned const threads) -> void
+                \brief Computes c = a b, c = c + a b or c = c - a b, for an m x k matrix a and a k x n matrix b. All three are
+                       row-major with rows lda, ldb and ldc elements apart.
+                \details Rows of c are split into blocks of row_block, distributed round-robin over threads, and
+                         columns into blocks of column_block. Each tile of c is accumulated in lazy_sum_traits<N>::type
+                         integers over the whole inner dimension and reduced only every chunk products, then once at
+                         the end. The innermost loop runs along a row of b, which is contiguous, so it vectorises.
+             */
+            template <s64 N, typename Reduction>
+            auto gemm(int_mod<N, Reduction> const *a, std::size_t const lda, int_mod<N, Reduction> const *b, std::size_t const ldb,
+                      int_mod<N, Reduction> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n,
+                      gemm_mode const mode, unsigned const threads) -> void;
+
+            /** \class scratch_arena<T>
+                \brief One allocation handed out as a stack of buffers, so recursive algorithms do not allocate per level.
+             */
+            template <typename T>
+            class scratch_arena
+            {
+            private:
+                /** \property std::vector<T> buffer_
+                    \brief Backing storage.
+                 */
+                std::vector<T> buffer_;
+
+                /** \property std::size_t used_
+                    \brief Elements handed out and not yet released.
+                 */
+                std::size_t used_{ 0 };
+
+            public:
+                /** \fn explicit scratch_arena(std::size_t const capacity)
+                    \brief Allocates room for capacity elements.
+                 */
+                explicit scratch_arena(std::size_t const capacity) : buffer_(capacity)
+                {
+                }
+
+                /** \fn auto take(std::size_t const count) noexcept -> T *
+                    \brief Returns the next count elements. The caller sized the arena, so running out is a bug.
+                 */
+                auto take(std::size_t const count) noexcept -> T *
+                {
+                    T *const result{ buffer_.data() + used_ };
+                    used_ += count;
+                    return result;
+                }
+
+                /** \fn auto mark() const noexcept -> std::size_t
+                    \brief Returns a position to release() back to.
+                 */
+                auto mark() const noexcept -> std::size_t
+                {
+                    return used_;
+                }
+
+                /** \fn auto release(std::size_t const mark) noexcept -> void
+                    \brief Frees every buffer taken since mark() returned mark.
+                 */
+                auto release(std::size_t const mark) noexcept -> void
+                {
+                    used_ = mark;
+                }
+            };
+
+            /** \fn constexpr auto winograd_scratch(std::size_t const m, std::size_t const k, std::size_t const n, std::size_t const cutoff) noexcept -> std::size_t
+                \brief Elements of scratch_arena that winograd() needs for an m x k by k x n product.
+             */
+            constexpr auto winograd_scratch(std::size_t const m, std::size_t const k, std::size_t const n, std::size_t const cutoff) noexcept -> std::size_t;
+
+            /** \fn auto winograd(int_mod<N> const *a, std::size_t const lda, int_mod<N> const *b, std::size_t const ldb, int_mod<N> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n, std::size_t const cutoff, scratch_arena<int_mod<N>> &arena, unsigned const threads) -> void
+                \brief Computes c = a b with the Strassen-Winograd recursion, switching to gemm() once a dimension is below cutoff.
+                \details Each level does 7 half-size products and 15 additions. The temporaries are one half-size
+                         block of a, one of b and one of c, taken from arena; the quarters of c hold the rest. Odd
+                         dimensions are peeled: the even part recurses, and the last row, column and inner index are
+                         fixed up with gemm().
+             */
+            template <s64 N, typename Reduction>
+            auto winograd(int_mod<N, Reduction> const *a, std::size_t const lda, int_mod<N, Reduction> const *b, std::size_t const ldb,
+                          int_mod<N, Reduction> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n,
+                          std::size_t const cutoff, scratch_arena<int_mod<N, Reduction>> &arena, unsigned const threads) -> void;
+
+            /** \struct echelon_result<T>
+                \brief What echelonize() did to a matrix.
+             */
+            template <typename T>
+            struct echelon_result
+            {
+                /** \property std::vector<std::size_t> pivot_columns
+                    \brief Column of the pivot in row i, for every pivot row i.
+                 */
+                std::vector<std::size_t> pivot_columns;
+
+                /** \property std::vector<T> pivots
+                    \brief Value of the pivot in row i, for every pivot row i.
+                 */
+                std::vector<T> pivots;
+
+                /** \property bool odd_swaps
+                    \brief True if an odd number of row swaps was made, which negates the determinant.
+                 */
+                bool odd_swaps{ false };
+            };
+
+            /** \enum elimination
+                \brief Which rows echelonize() clears around each pivot.
+             */
+            enum class elimination
+            {
+                below,       ///< Row echelon form; every operation has determinant 1 or -1.
+                above_below, ///< Also clears above unit pivots (Gauss-Jordan), or reduces above non-unit ones.
+                howell       ///< Row echelon form plus annihilator rows, so the non-zero rows form the Howell form.
+            };
+
+            /** \fn auto bezout(s64 const a, s64 const b) noexcept -> std::tuple<s64, s64, s64>
+                \brief Returns g = gcd(a, b) and s, t with sa + tb = g, for non-negative a and b, not both zero.
+             */
+            constexpr auto bezout(s64 const a, s64 const b) noexcept -> std::tuple<s64, s64, s64>;
+
+            /** \fn auto echelonize(std::vector<int_mod<N>> &a, std::size_t &rows, std::size_t const cols, std::size_t const pivot_limit, elimination const mode, unsigned const threads) -> echelon_result<int_mod<N>>
+                \brief Brings the row-major rows x cols matrix a into echelon form, choosing pivots among its first
+                       pivot_limit columns.
+                \details Columns are processed in panels of panel_width. Whenever a column has a unit entry, it is
+                         swapped into the pivot row and used to clear the column inside the panel only; the
+                         multipliers are kept, and the columns right of the panel are brought up to date for the
+                         whole panel at once with one gemm() call, which is lazily reduced and multithreaded.
+                         Moduli with zero divisors can leave a column whose entries are non-zero but none is a unit.
+                         After the pending update is flushed, such a column is cleared with unimodular
+                         \f$2 \times 2\f$ row operations built from Bezout coefficients, so the pivot becomes the gcd
+                         of the column. In howell mode, a non-unit pivot row p also adds the row \f$(N / \gcd(p, N)) p\f$,
+                         which is eliminated in later columns; rows therefore grows.
+             */
+            template <s64 N, typename Reduction>
+            auto echelonize(std::vector<int_mod<N, Reduction>> &a, std::size_t &rows, std::size_t const cols, std::size_t const pivot_limit,
+                            elimination const mode, unsigned const threads) -> echelon_result<int_mod<N, Reduction>>;
+
+        } // namespace impl_details
+
+        template <s64 N, typename Reduction>
+        class matrix<int_mod<N, Reduction>>
+        {
+        public:
+            /** \typedef value_type
+                \brief The entry type.
+             */
+            using value_type = int_mod<N, Reduction>;
+
+            /** \property static constexpr std::size_t parallel_threshold
+                \brief Products and eliminations with at least this many multiply-adds (m k n) use every hardware thread by default.
+             */
+            static constexpr std::size_t parallel_threshold{ std::size_t{ 1 } << 24 };
+
+            /** \property static constexpr std::size_t strassen_cutoff
+                \brief Products whose dimensions are all at least this large use the Strassen-Winograd recursion.
+             */
+            static constexpr std::size_t strassen_cutoff{ 128 };
+
+        private:
+            /** \property std::size_t rows_
+                \brief Number of rows.
+             */
+            std::size_t rows_{ 0 };
+
+            /** \property std::size_t cols_
+                \brief Number of columns.
+             */
+            std::size_t cols_{ 0 };
+
+            /** \property std::vector<value_type> data_
+                \brief Entries in row-major order.
+             */
+            std::vector<value_type> data_;
+
+            /** \fn static auto thread_count(std::size_t const work, unsigned const threads) noexcept -> unsigned
+                \brief Returns threads, or if it is 0, every hardware thread when work reaches parallel_threshold and 1 otherwise.
+             */
+            static auto thread_count(std::size_t const work, unsigned const threads) noexcept -> unsigned;
+
+        public:
+            /** \fn matrix()
+                \brief Constructs a 0 x 0 matrix.
+             */
+            matrix() = default;
+
+            /** \fn matrix(std::size_t const rows, std::size_t const cols)
+                \brief Constructs a rows x cols zero matrix.
+             */
+            matrix(std::size_t const rows, std::size_t const cols);
+
+            /** \fn matrix(std::initializer_list<std::initializer_list<value_type>> const rows)
+                \brief Constructs a matrix row by row. Throws std::invalid_argument if the rows differ in length.
+             */
+            matrix(std::initializer_list<std::initializer_list<value_type>> const rows);
+
+            /** \fn static auto identity(std::size_t const n) -> matrix<int_mod<N>>
+                \brief Returns the n x n identity matrix.
+             */
+            static auto identity(std::size_t const n) -> matrix;
+
+            /** \fn auto rows() const noexcept -> std::size_t
+                \brief Returns the number of rows.
+             */
+            auto rows() const noexcept -> std::size_t
+            {
+                return rows_;
+            }
+
+            /** \fn auto cols() const noexcept -> std::size_t
+                \brief Returns the number of columns.
+             */
+            auto cols() const noexcept -> std::size_t
+            {
+                return cols_;
+            }
+
+            /** \fn auto operator()(std::size_t const i, std::size_t const j) noexcept -> int_mod<N> &
+                \brief Returns the entry in row i and column j. Indices are not checked.
+             */
+            auto operator()(std::size_t const i, std::size_t const j) noexcept -> value_type &
+            {
+                return data_[i * cols_ + j];
+            }
+
+            /** \fn auto operator()(std::size_t const i, std::size_t const j) const noexcept -> int_mod<N>
+                \brief Returns the entry in row i and column j. Indices are not checked.
+             */
+            auto operator()(std::size_t const i, std::size_t const j) const noexcept -> value_type
+            {
+                return data_[i * cols_ + j];
+            }
+
+            /** \fn auto row(std::size_t const i) noexcept -> std::span<int_mod<N>>
+                \brief Returns row i.
+             */
+            auto row(std::size_t const i) noexcept -> std::span<value_type>
+            {
+                return std::span{ data_ }.subspan(i * cols_, cols_);
+            }
+
+            /** \fn auto row(std::size_t const i) const noexcept -> std::span<int_mod<N> const>
+                \brief Returns row i.
+             */
+            auto row(std::size_t const i) const noexcept -> std::span<value_type const>
+            {
+                return std::span{ data_ }.subspan(i * cols_, cols_);
+            }
+
+            /** \fn auto data() noexcept -> int_mod<N> *
+                \brief Returns the entries in row-major order.
+             */
+            auto data() noexcept -> value_type *
+            {
+                return data_.data();
+            }
+
+            /** \fn auto data() const noexcept -> int_mod<N> const *
+                \brief Returns the entries in row-major order.
+             */
+            auto data() const noexcept -> value_type const *
+            {
+                return data_.data();
+            }
+
+            /** \fn auto transpose() const -> matrix<int_mod<N>>
+                \brief Returns the transpose.
+             */
+            auto transpose() const -> matrix;
+
+            /** \fn static auto multiply(matrix<int_mod<N>> const &lhs, matrix<int_mod<N>> const &rhs, unsigned threads = 0) -> matrix<int_mod<N>>
+                \brief Returns lhs rhs using impl_details::gemm on threads threads. 0 picks one thread below
+                       parallel_threshold and std::thread::hardware_concurrency() above it.
+                       Throws std::invalid_argument if the inner dimensions differ.
+             */
+            static auto multiply(matrix const &lhs, matrix const &rhs, unsigned threads = 0) -> matrix;
+
+            /** \fn auto determinant(unsigned threads = 0) const -> int_mod<N>
+                \brief Returns the determinant of a square matrix.
+                \details Reduces a copy to echelon form with row operations of determinant \f$\pm 1\f$ only, so composite
+                         N is handled as well, then multiplies the pivots. threads works as in multiply().
+             */
+            auto determinant(unsigned threads = 0) const -> value_type;
+
+            /** \fn auto rank(unsigned threads = 0) const -> std::size_t
+                \brief Returns the number of non-zero rows of the Howell form, which is the usual rank when N is prime.
+                \details For composite N the Howell form is the canonical echelon basis of the row span, and it can
+                         have more rows than the matrix: the span of [2 1] modulo 4 also contains [0 2], so its rank is 2.
+             */
+            auto rank(unsigned threads = 0) const -> std::size_t;
+
+            /** \fn auto try_inverse(unsigned threads = 0) const -> std::optional<matrix<int_mod<N>>>
+                \brief Returns the inverse, or std::nullopt if the matrix is not square or its determinant is not a unit.
+                \details Gauss-Jordan elimination of [A | I]; the pivots are inverted together with batch_inverse()
+                         when the rows are normalised.
+             */
+            auto try_inverse(unsigned threads = 0) const -> std::optional<matrix>;
+
+            /** \fn auto inverse(unsigned threads = 0) const -> matrix<int_mod<N>>
+                \brief Returns the inverse, throwing std::invalid_argument if there is none.
+             */
+            auto inverse(unsigned threads = 0) const -> matrix;
+
+            /** \fn auto operator+=(matrix<int_mod<N>> const &rhs) -> matrix<int_mod<N>> &
+                \brief Adds rhs. Throws std::invalid_argument if the shapes differ.
+             */
+            auto operator+=(matrix const &rhs) -> matrix &;
+
+            /** \fn auto operator-=(matrix<int_mod<N>> const &rhs) -> matrix<int_mod<N>> &
+                \brief Subtracts rhs. Throws std::invalid_argument if the shapes differ.
+             */
+            auto operator-=(matrix const &rhs) -> matrix &;
+
+            /** \fn auto operator*=(matrix<int_mod<N>> const &rhs) -> matrix<int_mod<N>> &
+                \brief Multiplies by rhs on the right. See multiply().
+             */
+            auto operator*=(matrix const &rhs) -> matrix &;
+
+            /** \fn auto operator*=(int_mod<N> const rhs) -> matrix<int_mod<N>> &
+                \brief Multiplies every entry by rhs.
+             */
+            auto operator*=(value_type const rhs) -> matrix &;
+
+            /** \fn auto operator==(matrix<int_mod<N>> const &rhs) const noexcept -> bool
+                \brief Returns true if both matrices have the same shape and entries.
+             */
+            auto operator==(matrix const &rhs) const noexcept -> bool
+            {
+                return rows_ == rhs.rows_ && cols_ == rhs.cols_ && data_ == rhs.data_;
+            }
+
+            /** \fn auto operator!=(matrix<int_mod<N>> const &rhs) const noexcept -> bool
+                \brief Returns true if the matrices differ.
+             */
+            auto operator!=(matrix const &rhs) const noexcept -> bool
+            {
+                return !(*this == rhs);
+            }
+        };
+
+        /** \fn auto operator+(matrix<T> lhs, matrix<T> const &rhs) -> matrix<T>
+            \brief Returns the sum of two matrices.
+         */
+        template <typename T>
+        auto operator+(matrix<T> lhs, matrix<T> const &rhs) -> matrix<T>
+        {
+            return lhs += rhs;
+        }
+
+        /** \fn auto operator-(matrix<T> lhs, matrix<T> const &rhs) -> matrix<T>
+            \brief Returns the difference of two matrices.
+         */
+        template <typename T>
+        auto operator-(matrix<T> lhs, matrix<T> const &rhs) -> matrix<T>
+        {
+            return lhs -= rhs;
+        }
+
+        /** \fn auto operator*(matrix<T> const &lhs, matrix<T> const &rhs) -> matrix<T>
+            \brief Returns the product of two matrices.
+         */
+        template <typename T>
+        auto operator*(matrix<T> const &lhs, matrix<T> const &rhs) -> matrix<T>
+        {
+            return matrix<T>::multiply(lhs, rhs);
+        }
+
+        /** \fn auto operator*(matrix<T> lhs, T const rhs) -> matrix<T>
+            \brief Returns the matrix scaled by rhs.
+         */
+        template <typename T>
+        auto operator*(matrix<T> lhs, T const rhs) -> matrix<T>
+        {
+            return lhs *= rhs;
+        }
+
+        namespace impl_details
+        {
+            template <s64 N, typename Reduction>
+            auto gemm(int_mod<N, Reduction> const *a, std::size_t const lda, int_mod<N, Reduction> const *b, std::size_t const ldb,
+                      int_mod<N, Reduction> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n,
+                      gemm_mode const mode, unsigned const threads) -> void
+            {
+                using traits = lazy_sum_traits<N>;
+                using acc_type = typename traits::type;
+
+                constexpr std::size_t row_block{ 32 };
+                constexpr std::size_t column_block{ std::is_same_v<acc_type, u64> ? 256 : 128 };
+
+                auto const row_blocks = (m + row_block - 1) / row_block;
+
+                auto const worker = [&](std::size_t const first_block, std::size_t const stride)
+                {
+                    std::vector<acc_type> tile(row_block * column_block);
+
+                    for( std::size_t ib{ first_block }; ib < row_blocks; ib += stride )
+                    {
+                        std::size_t const i0{ ib * row_block };
+                        std::size_t const i1{ std::min(m, i0 + row_block) };
+
+                        for( std::size_t j0{ 0 }; j0 < n; j0 += column_block )
+                        {
+                            std::size_t const width{ std::min(n - j0, column_block) };
+
+                            if constexpr( traits::chunk == 0 )
+                            {   // No accumulator can hold a product, so reduce each one.
+                                for( std::size_t i{ i0 }; i < i1; ++i )
+                                {
+                                    if( mode == gemm_mode::assign )
+                                    {
+                                        std::fill(c + i * ldc + j0, c + i * ldc + j0 + width, int_mod<N, Reduction>{ 0 });
+                                    }
+
+                                    for( std::size_t p{ 0 }; p < k; ++p )
+                                    {
+                                        for( std::size_t j{ j0 }; j < j0 + width; ++j )
+                                        {
+                                            if( mode == gemm_mode::subtract )
+                                            {
+                                                c[i * ldc + j] -= a[i * lda + p] * b[p * ldb + j];
+                                            }
+                                            else
+                                            {
+                                                c[i * ldc + j] += a[i * lda + p] * b[p * ldb + j];
+                                            }
+                                        }
+                                    }
+                                }
+
+                                continue;
+                            }
+
+                            std::fill(tile.begin(), tile.end(), acc_type{ 0 });
+
+                            for( std::size_t p0{ 0 }; p0 < k; )
+                            {   // Every entry of the tile is below N here, so it can take chunk more products.
+                                std::size_t const p1{ p0 + static_cast<std::size_t>(std::min<u64>(traits::chunk, k - p0)) };
+
+                                for( std::size_t i{ i0 }; i < i1; ++i )
+                                {
+                                    acc_type *const acc{ tile.data() + (i - i0) * column_block };
+
+                                    for( std::size_t p{ p0 }; p < p1; ++p )
+                                    {
+                                        acc_type const x{ static_cast<acc_type>(a[i * lda + p].value()) };
+                                        int_mod<N, Reduction> const *const b_row{ b + p * ldb + j0 };
+
+                                        for( std::size_t j{ 0 }; j < width; ++j )
+                                        {
+                                            acc[j] += x * static_cast<acc_type>(b_row[j].value());
+                                        }
+                                    }
+
+                                    if( p1 < k )
+                                    {
+                                        for( std::size_t j{ 0 }; j < width; ++j )
+                                        {
+                                            acc[j] = static_cast<acc_type>(Reduction::template reduce<N>(acc[j]));
+                                        }
+                                    }
+                                }
+
+                                p0 = p1;
+                            }
+
+                            for( std::size_t i{ i0 }; i < i1; ++i )
+                            {
+                                acc_type const *const acc{ tile.data() + (i - i0) * column_block };
+
+                                int_mod<N, Reduction> *const c_row{ c + i * ldc + j0 };
+
+                                for( std::size_t j{ 0 }; j < width; ++j )
+                                {
+                                    int_mod<N, Reduction> const sum{ Reduction::template reduce<N>(acc[j]) };
+
+                                    if( mode == gemm_mode::assign )
+                                    {
+                                        c_row[j] = sum;
+                                    }
+                                    else if( mode == gemm_mode::add )
+                                    {
+                                        c_row[j] += sum;
+                                    }
+                                    else
+                                    {
+                                        c_row[j] -= sum;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                };
+
+                unsigned const workers{ static_cast<unsigned>(std::min<std::size_t>(std::max(threads, 1u), row_blocks)) };
+
+                if( workers <= 1 )
+                {
+                    worker(0, 1);
+                    return;
+                }
+
+                std::vector<std::thread> pool;
+                pool.reserve(workers - 1);
+
+                for( unsigned t{ 1 }; t < workers; ++t )
+                {
+                    pool.emplace_back(worker, t, workers);
+                }
+
+                worker(0, workers);
+
+                for( auto &thread : pool )
+                {
+                    thread.join();
+                }
+            }
+
+            constexpr auto winograd_scratch(std::size_t const m, std::size_t const k, std::size_t const n, std::size_t const cutoff) noexcept -> std::size_t
+            {
+                if( std::min({ m, k, n }) < cutoff )
+                {
+                    return 0;
+                }
+
+                std::size_t const hm{ m / 2 };
+                std::size_t const hk{ k / 2 };
+                std::size_t const hn{ n / 2 };
+
+                return hm * hk + hk * hn + hm * hn + winograd_scratch(hm, hk, hn, cutoff);
+            }
+
+            template <s64 N, typename Reduction>
+            auto winograd(int_mod<N, Reduction> const *a, std::size_t const lda, int_mod<N, Reduction> const *b, std::size_t const ldb,
+                          int_mod<N, Reduction> *c, std::size_t const ldc, std::size_t const m, std::size_t const k, std::size_t const n,
+                          std::size_t const cutoff, scratch_arena<int_mod<N, Reduction>> &arena, unsigned const threads) -> void
+            {
+                using T = int_mod<N, Reduction>;
+
+                if( std::min({ m, k, n }) < cutoff )
+                {
+                    gemm(a, lda, b, ldb, c, ldc, m, k, n, gemm_mode::assign, threads);
+                    return;
+                }
+
+                std::size_t const hm{ m / 2 };
+                std::size_t const hk{ k / 2 };
+                std::size_t const hn{ n / 2 };
+
+                // out = x + y or x - y, row by row, for rows x cols blocks.
+                auto const combine = [](T const *x, std::size_t const ldx, T const *y, std::size_t const ldy, T *out, std::size_t const ldo,
+                                        std::size_t const rows, std::size_t const cols, bool const subtract)
+                {
+                    for( std::size_t i{ 0 }; i < rows; ++i )
+                    {
+                        std::span<T const> const x_row{ x + i * ldx, cols };
+                        std::span<T const> const y_row{ y + i * ldy, cols };
+                        std::span<T> const out_row{ out + i * ldo, cols };
+
+                        if( subtract )
+                        {
+                            vector_sub(x_row, y_row, out_row);
+                        }
+                        else
+                        {
+                            vector_add(x_row, y_row, out_row);
+                        }
+                    }
+                };
+
+                T const *const a11{ a };
+                T const *const a12{ a + hk };
+                T const *const a21{ a + hm * lda };
+                T const *const a22{ a + hm * lda + hk };
+                T const *const b11{ b };
+                T const *const b12{ b + hn };
+                T const *const b21{ b + hk * ldb };
+                T const *const b22{ b + hk * ldb + hn };
+                T *const c11{ c };
+                T *const c12{ c + hn };
+                T *const c21{ c + hm * ldc };
+                T *const c22{ c + hm * ldc + hn };
+
+                std::size_t const mark{ arena.mark() };
+                T *const x{ arena.take(hm * hk) };
+                T *const y{ arena.take(hk * hn) };
+                T *const q{ arena.take(hm * hn) };
+
+                auto const multiply = [&](T const *lhs, std::size_t const ld_lhs, T const *rhs, std::size_t const ld_rhs, T *out, std::size_t const ld_out)
+                {
+                    winograd(lhs, ld_lhs, rhs, ld_rhs, out, ld_out, hm, hk, hn, cutoff, arena, threads);
+                };
+
+                combine(a11, lda, a21, lda, x, hk, hm, hk, true);  // S3 = A11 - A21
+                combine(b22, ldb, b12, ldb, y, hn, hk, hn, true);  // T3 = B22 - B12
+                multiply(x, hk, y, hn, c21, ldc);                  // P7 = S3 T3
+                combine(a21, lda, a22, lda, x, hk, hm, hk, false); // S1 = A21 + A22
+                combine(b12, ldb, b11, ldb, y, hn, hk, hn, true);  // T1 = B12 - B11
+                multiply(x, hk, y, hn, c22, ldc);                  // P5 = S1 T1
+                combine(x, hk, a11, lda, x, hk, hm, hk, true);     // S2 = S1 - A11
+                combine(b22, ldb, y, hn, y, hn, hk, hn, true);     // T2 = B22 - T1
+                multiply(x, hk, y, hn, c12, ldc);                  // P6 = S2 T2
+                combine(a12, lda, x, hk, x, hk, hm, hk, true);     // S4 = A12 - S2
+                multiply(x, hk, b22, ldb, c11, ldc);               // P3 = S4 B22
+                multiply(a11, lda, b11, ldb, q, hn);               // P1 = A11 B11
+                combine(c12, ldc, q, hn, c12, ldc, hm, hn, false); // U2 = P1 + P6
+                combine(c21, ldc, c12, ldc, c21, ldc, hm, hn, false); // U3 = U2 + P7
+                combine(c12, ldc, c22, ldc, c12, ldc, hm, hn, false); // U4 = U2 + P5
+                combine(c22, ldc, c21, ldc, c22, ldc, hm, hn, false); // C22 = U3 + P5
+                combine(c12, ldc, c11, ldc, c12, ldc, hm, hn, false); // C12 = U4 + P3
+                combine(y, hn, b21, ldb, y, hn, hk, hn, true);     // T4 = T2 - B21
+                multiply(a22, lda, y, hn, c11, ldc);               // P4 = A22 T4
+                combine(c21, ldc, c11, ldc, c21, ldc, hm, hn, true); // C21 = U3 - P4
+                multiply(a12, lda, b21, ldb, c11, ldc);            // P2 = A12 B21
+                combine(c11, ldc, q, hn, c11, ldc, hm, hn, false); // C11 = P1 + P2
+
+                arena.release(mark);
+
+                // Peel odd dimensions.
+                if( k != 2 * hk )
+                {
+                    gemm(a + 2 * hk, lda, b + 2 * hk * ldb, ldb, c, ldc, 2 * hm, 1, 2 * hn, gemm_mode::add, threads);
+                }
+
+                if( n != 2 * hn )
+                {
+                    gemm(a, lda, b + 2 * hn, ldb, c + 2 * hn, ldc, m, k, 1, gemm_mode::assign, threads);
+                }
+
+                if( m != 2 * hm )
+                {
+                    gemm(a + 2 * hm * lda, lda, b, ldb, c + 2 * hm * ldc, ldc, 1, k, 2 * hn, gemm_mode::assign, threads);
+                }
+            }
+
+            constexpr auto bezout(s64 const a, s64 const b) noexcept -> std::tuple<s64, s64, s64>
+            {
+                s64 r0{ a };
+                s64 r1{ b };
+                s64 s0{ 1 };
+                s64 s1{ 0 };
+                s64 t0{ 0 };
+                s64 t1{ 1 };
+
+                while( r1 != 0 )
+                {
+                    s64 const q{ r0 / r1 };
+
+                    r0 = std::exchange(r1, r0 - q * r1);
+                    s0 = std::exchange(s1, s0 - q * s1);
+                    t0 = std::exchange(t1, t0 - q * t1);
+                }
+
+                return { r0, s0, t0 };
+            }
+
+            template <s64 N, typename Reduction>
+            auto echelonize(std::vector<int_mod<N, Reduction>> &a, std::size_t &rows, std::size_t const cols, std::size_t const pivot_limit,
+                            elimination const mode, unsigned const threads) -> echelon_result<int_mod<N, Reduction>>
+            {
+                using T = int_mod<N, Reduction>;
+
+                constexpr std::size_t panel_width{ 64 };
+
+                bool const full{ mode == elimination::above_below };
+
+                echelon_result<T> result;
+
+                auto const row_ptr = [&](std::size_t const i) { return a.data() + i * cols; };
+
+                auto const swap_rows = [&](std::size_t const i, std::size_t const j)
+                {
+                    std::swap_ranges(row_ptr(i), row_ptr(i) + cols, row_ptr(j));
+                    result.odd_swaps = !result.odd_swaps;
+                };
+
+                std::size_t r0{ 0 }; // Next pivot row.
+
+                for( std::size_t c0{ 0 }; c0 < pivot_limit; c0 += panel_width )
+                {
+                    std::size_t const c1{ std::min(pivot_limit, c0 + panel_width) };
+                    std::size_t const trailing{ cols - c1 };
+
+                    // mult[i * panel_width + j] is the multiple of pending pivot j subtracted from row i, so far only
+                    // inside the panel. Pending pivots occupy rows first, first + 1, ..., first + pending - 1.
+                    std::vector<T> mult(rows * panel_width);
+                    std::size_t first{ r0 };
+                    std::size_t pending{ 0 };
+
+                    auto const flush = [&]()
+                    {
+                        if( pending == 0 || trailing == 0 )
+                        {
+                            pending = 0;
+                            return;
+                        }
+
+                        // Pivot row j entered the panel already reduced by the pivots before it, so its trailing part
+                        // as it was then is v_j = row_j - sum_{i < j} mult[row_j][i] v_i.
+                        std::vector<T> v(pending * trailing);
+
+                        for( std::size_t j{ 0 }; j < pending; ++j )
+                        {
+                            T *const v_j{ v.data() + j * trailing };
+                            std::copy(row_ptr(first + j) + c1, row_ptr(first + j) + cols, v_j);
+
+                            for( std::size_t i{ 0 }; i < j; ++i )
+                            {
+                                T const f{ mult[(first + j) * panel_width + i] };
+
+                                if( f != 0 )
+                                {
+                                    T const *const v_i{ v.data() + i * trailing };
+
+                                    for( std::size_t x{ 0 }; x < trailing; ++x )
+                                    {
+                                        v_j[x] -= f * v_i[x];
+                                    }
+                                }
+                            }
+                        }
+
+                        // Every row, pivot rows included, then ends up as itself minus its multipliers times v.
+                        std::size_t const top{ full ? 0 : first };
+
+                        gemm(mult.data() + top * panel_width, panel_width, v.data(), trailing, row_ptr(top) + c1, cols,
+                             rows - top, pending, trailing, gemm_mode::subtract, threads);
+
+                        pending = 0;
+                    };
+
+                    for( std::size_t c{ c0 }; c < c1 && r0 < rows; ++c )
+                    {
+                        std::size_t unit{ rows };
+                        std::size_t nonzero{ rows };
+
+                        for( std::size_t i{ r0 }; i < rows; ++i )
+                        {
+                            s64 const x{ row_ptr(i)[c].value() };
+
+                            if( x != 0 )
+                            {
+                                nonzero = std::min(nonzero, i);
+
+                                if( gcd(x, N) == 1 )
+                                {
+                                    unit = i;
+                                    break;
+                                }
+                            }
+                        }
+
+                        if( nonzero == rows )
+                        {
+                            continue;
+                        }
+
+                        if( unit != rows )
+                        {   // Fast path: clear the column with the unit inside the panel and defer the rest.
+                            if( unit != r0 )
+                            {
+                                swap_rows(unit, r0);
+                                std::swap_ranges(mult.begin() + unit * panel_width, mult.begin() + (unit + 1) * panel_width,
+                                                 mult.begin() + r0 * panel_width);
+                            }
+
+                            T const *const pivot_row{ row_ptr(r0) };
+                            T const pivot{ pivot_row[c] };
+                            T const pivot_inverse{ pivot.inverse() };
+
+                            for( std::size_t i{ full ? 0 : r0 + 1 }; i < rows; ++i )
+                            {
+                                T *const row{ row_ptr(i) };
+
+                                if( i == r0 || row[c] == 0 )
+                                {
+                                    continue;
+                                }
+
+                                T const f{ row[c] * pivot_inverse };
+
+                                for( std::size_t x{ c }; x < c1; ++x )
+                                {
+                                    row[x] -= f * pivot_row[x];
+                                }
+
+                                mult[i * panel_width + pending] = f;
+                            }
+
+                            result.pivot_columns.push_back(c);
+                            result.pivots.push_back(pivot);
+                            ++pending;
+                            ++r0;
+                            continue;
+                        }
+
+                        // No unit in the column: bring every row up to date and fold the column into its gcd.
+                        flush();
+                        std::fill(mult.begin(), mult.end(), T{ 0 });
+                        first = r0 + 1;
+
+                        if( nonzero != r0 )
+                        {
+                            swap_rows(nonzero, r0);
+                        }
+
+                        T *const pivot_row{ row_ptr(r0) };
+
+                        for( std::size_t i{ r0 + 1 }; i < rows; ++i )
+                        {
+                            T *const row{ row_ptr(i) };
+
+                            if( row[c] == 0 )
+                            {
+                                continue;
+                            }
+
+                            // [s t; -v u] has determinant (s a + t b) / g = 1, so the pair of rows spans the same module.
+                            auto const [g, s, t] = bezout(pivot_row[c].value(), row[c].value());
+                            T const u{ pivot_row[c].value() / g };
+                            T const v{ row[c].value() / g };
+
+                            for( std::size_t x{ c }; x < cols; ++x )
+                            {
+                                T const p{ pivot_row[x] };
+                                pivot_row[x] = T{ s } * p + T{ t } * row[x];
+                                row[x] = u * row[x] - v * p;
+                            }
+                        }
+
+                        T const pivot{ pivot_row[c] };
+
+                        if( full )
+                        {
+                            auto const pivot_inverse = pivot.try_inverse();
+
+                            for( std::size_t i{ 0 }; i < r0; ++i )
+                            {
+                                T *const row{ row_ptr(i) };
+
+                                // Clear the entry if the pivot is a unit, otherwise reduce it below the pivot.
+                                T const f{ pivot_inverse ? row[c] * *pivot_inverse : T{ row[c].value() / pivot.value() } };
+
+                                if( f == 0 )
+                                {
+                                    continue;
+                                }
+
+                                for( std::size_t x{ c }; x < cols; ++x )
+                                {
+                                    row[x] -= f * pivot_row[x];
+                                }
+                            }
+                        }
+                        else if( mode == elimination::howell )
+                        {   // (N / gcd(pivot, N)) times the pivot row is zero in column c but may not be in the span
+                            // of the rows below, so it joins them.
+                            s64 const annihilator{ N / gcd(pivot.value(), N) };
+
+                            if( annihilator != N )
+                            {
+                                a.resize(a.size() + cols);
+                                T const *const source{ row_ptr(r0) };
+                                T *const target{ row_ptr(rows) };
+
+                                bool any{ false };
+
+                                for( std::size_t x{ c + 1 }; x < cols; ++x )
+                                {
+                                    target[x] = T{ annihilator } * source[x];
+                                    any = any || target[x] != 0;
+                                }
+
+                                if( any )
+                                {
+                                    ++rows;
+                                    mult.resize(rows * panel_width);
+                                }
+                                else
+                                {
+                                    a.resize(a.size() - cols);
+                                }
+                            }
+                        }
+
+                        result.pivot_columns.push_back(c);
+                        result.pivots.push_back(pivot);
+                        ++r0;
+                    }
+
+                    flush();
+                }
+
+                return result;
+            }
+
+        } // namespace impl_details
+
+        template <s64 N, typename Reduction>
+        matrix<int_mod<N, Reduction>>::matrix(std::size_t const rows, std::size_t const cols)
+            : rows_{ rows }, cols_{ cols }, data_(rows * cols)
+        {
+        }
+
+        template <s64 N, typename Reduction>
+        matrix<int_mod<N, Reduction>>::matrix(std::initializer_list<std::initializer_list<value_type>> const rows)
+            : rows_{ rows.size() }, cols_{ rows.size() == 0 ? 0 : rows.begin()->size() }
+        {
+            data_.reserve(rows_ * cols_);
+
+            for( auto const &row : rows )
+            {
+                if( row.size() != cols_ )
+                {
+                    throw std::invalid_argument{ "Matrix rows must all have the same length.\n" };
+                }
+
+                data_.insert(data_.end(), row.begin(), row.end());
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::identity(std::size_t const n) -> matrix
+        {
+            matrix result(n, n);
+
+            for( std::size_t i{ 0 }; i < n; ++i )
+            {
+                result(i, i) = 1;
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::transpose() const -> matrix
+        {
+            matrix result(cols_, rows_);
+
+            for( std::size_t i{ 0 }; i < rows_; ++i )
+            {
+                for( std::size_t j{ 0 }; j < cols_; ++j )
+                {
+                    result(j, i) = (*this)(i, j);
+                }
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::thread_count(std::size_t const work, unsigned const threads) noexcept -> unsigned
+        {
+            if( threads != 0 )
+            {
+                return threads;
+            }
+
+            return work >= parallel_threshold ? std::max(std::thread::hardware_concurrency(), 1u) : 1u;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::multiply(matrix const &lhs, matrix const &rhs, unsigned threads) -> matrix
+        {
+            if( lhs.cols_ != rhs.rows_ )
+            {
+                throw std::invalid_argument("Cannot multiply a " + std::to_string(lhs.rows_) + "x" + std::to_string(lhs.cols_)
+                    + " matrix by a " + std::to_string(rhs.rows_) + "x" + std::to_string(rhs.cols_) + " matrix.\n");
+            }
+
+            threads = thread_count(lhs.rows_ * lhs.cols_ * rhs.cols_, threads);
+
+            matrix result(lhs.rows_, rhs.cols_);
+
+            if( std::min({ lhs.rows_, lhs.cols_, rhs.cols_ }) >= strassen_cutoff )
+            {
+                impl_details::scratch_arena<value_type> arena{ impl_details::winograd_scratch(lhs.rows_, lhs.cols_, rhs.cols_, strassen_cutoff) };
+                impl_details::winograd(lhs.data(), lhs.cols_, rhs.data(), rhs.cols_, result.data(), result.cols_,
+                                       lhs.rows_, lhs.cols_, rhs.cols_, strassen_cutoff, arena, threads);
+            }
+            else if( lhs.cols_ != 0 )
+            {
+                impl_details::gemm(lhs.data(), lhs.cols_, rhs.data(), rhs.cols_, result.data(), result.cols_,
+                                   lhs.rows_, lhs.cols_, rhs.cols_, impl_details::gemm_mode::assign, threads);
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::determinant(unsigned threads) const -> value_type
+        {
+            if( rows_ != cols_ )
+            {
+                throw std::invalid_argument("Determinant requires a square matrix, but this one is " + std::to_string(rows_) + "x"
+                    + std::to_string(cols_) + ".\n");
+            }
+
+            std::vector<value_type> a{ data_ };
+            std::size_t rows{ rows_ };
+
+            auto const echelon = impl_details::echelonize(a, rows, cols_, cols_, impl_details::elimination::below,
+                                                          thread_count(rows_ * rows_ * cols_, threads));
+
+            if( echelon.pivots.size() < rows_ )
+            {
+                return value_type{ 0 };
+            }
+
+            value_type result{ echelon.odd_swaps ? -1 : 1 };
+
+            for( auto const pivot : echelon.pivots )
+            {
+                result *= pivot;
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::rank(unsigned threads) const -> std::size_t
+        {
+            std::vector<value_type> a{ data_ };
+            std::size_t rows{ rows_ };
+
+            return impl_details::echelonize(a, rows, cols_, cols_, impl_details::elimination::howell,
+                                            thread_count(rows_ * cols_ * std::min(rows_, cols_), threads)).pivots.size();
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::try_inverse(unsigned threads) const -> std::optional<matrix>
+        {
+            if( rows_ != cols_ )
+            {
+                return std::nullopt;
+            }
+
+            std::size_t const n{ rows_ };
+
+            // [A | I]
+            std::vector<value_type> a(n * 2 * n);
+
+            for( std::size_t i{ 0 }; i < n; ++i )
+            {
+                std::copy(data_.begin() + i * n, data_.begin() + (i + 1) * n, a.begin() + i * 2 * n);
+                a[i * 2 * n + n + i] = 1;
+            }
+
+            std::size_t rows{ n };
+            auto echelon = impl_details::echelonize(a, rows, 2 * n, n, impl_details::elimination::above_below,
+                                                    thread_count(2 * n * n * n, threads));
+
+            if( echelon.pivots.size() < n || batch_inverse(std::span{ echelon.pivots }) != n )
+            {
+                return std::nullopt;
+            }
+
+            // Pivot i sits at (i, i) and is a unit, so every other entry of the left half is zero.
+            matrix result(n, n);
+
+            for( std::size_t i{ 0 }; i < n; ++i )
+            {
+                for( std::size_t j{ 0 }; j < n; ++j )
+                {
+                    result.data_[i * n + j] = a[i * 2 * n + n + j] * echelon.pivots[i];
+                }
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::inverse(unsigned threads) const -> matrix
+        {
+            if( rows_ != cols_ )
+            {
+                throw std::invalid_argument("Cannot invert a " + std::to_string(rows_) + "x" + std::to_string(cols_) + " matrix.\n");
+            }
+
+            auto result = try_inverse(threads);
+
+            if( !result )
+            {
+                throw std::invalid_argument("Matrix is not invertible modulo " + std::to_string(N) + ".\n");
+            }
+
+            return *std::move(result);
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::operator+=(matrix const &rhs) -> matrix &
+        {
+            if( rows_ != rhs.rows_ || cols_ != rhs.cols_ )
+            {
+                throw std::invalid_argument("Cannot add a " + std::to_string(rhs.rows_) + "x" + std::to_string(rhs.cols_)
+                    + " matrix to a " + std::to_string(rows_) + "x" + std::to_string(cols_) + " matrix.\n");
+            }
+
+            for( std::size_t i{ 0 }; i < data_.size(); ++i )
+            {
+                data_[i] += rhs.data_[i];
+            }
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::operator-=(matrix const &rhs) -> matrix &
+        {
+            if( rows_ != rhs.rows_ || cols_ != rhs.cols_ )
+            {
+                throw std::invalid_argument("Cannot subtract a " + std::to_string(rhs.rows_) + "x" + std::to_string(rhs.cols_)
+                    + " matrix from a " + std::to_string(rows_) + "x" + std::to_string(cols_) + " matrix.\n");
+            }
+
+            for( std::size_t i{ 0 }; i < data_.size(); ++i )
+            {
+                data_[i] -= rhs.data_[i];
+            }
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::operator*=(matrix const &rhs) -> matrix &
+        {
+            *this = multiply(*this, rhs);
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto matrix<int_mod<N, Reduction>>::operator*=(value_type const rhs) -> matrix &
+        {
+            fixed_multiplier<N, Reduction> const factor{ rhs };
+
+            for( auto &x : data_ )
+            {
+                x *= factor;
+            }
+
+            return *this;
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
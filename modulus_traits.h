@@ -0,0 +1,369 @@
+#pragma once
+#ifndef MATH_NERD_MODULUS_TRAITS_H
+#define MATH_NERD_MODULUS_TRAITS_H
+
+/** \file modulus_traits.h
+    \brief Number-theoretic facts about a modulus N, all computed at compile time: primality, factorisation, phi,
+           Carmichael lambda, primitive root and the 2-adic order of N - 1.
+ */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        namespace impl_details
+        {
+            /** \fn constexpr auto pollard_rho(u64 const n) -> u64
+                \brief Returns a non-trivial factor of the odd composite n using Brent's variant of Pollard's rho.
+             */
+            constexpr auto pollard_rho(u64 const n) -> u64;
+
+            /** \fn constexpr auto factorize(s64 n) -> std::vector<std::pair<s64, int>>
+                \brief Returns the prime factorisation of n > 0 as (prime, exponent) pairs in increasing order of prime.
+                \details Small factors are removed by trial division, the rest by Pollard's rho with Brent's cycle detection.
+                         Usable in constant expressions, as long as the vector does not outlive the evaluation.
+             */
+            constexpr auto factorize(s64 n) -> std::vector<std::pair<s64, int>>;
+
+            /** \struct prime_factorization
+                \brief A factorisation in fixed storage, so it can be a constexpr static member.
+                \details 15 slots suffice: the product of the first 16 primes exceeds \f$2^{63}\f$.
+             */
+            struct prime_factorization
+            {
+                /** \property std::array<std::pair<s64, int>, 15> factors
+                    \brief (prime, exponent) pairs in increasing order of prime; the first count are used.
+                 */
+                std::array<std::pair<s64, int>, 15> factors{ };
+
+                /** \property int count
+                    \brief Number of distinct primes.
+                 */
+                int count{ 0 };
+            };
+
+            /** \fn constexpr auto factorize_fixed(s64 const n) -> prime_factorization
+                \brief factorize() into a prime_factorization.
+             */
+            constexpr auto factorize_fixed(s64 const n) -> prime_factorization;
+
+            /** \fn constexpr auto carmichael_of(prime_factorization const &f) noexcept -> s64
+                \brief Returns the Carmichael function, the exponent of the unit group, of the number factored as f.
+             */
+            constexpr auto carmichael_of(prime_factorization const &f) noexcept -> s64;
+
+            /** \fn constexpr auto least_primitive_root(s64 const n, prime_factorization const &f) -> s64
+                \brief Returns the least primitive root modulo n > 2 factored as f, or 0 if the unit group is not cyclic.
+             */
+            constexpr auto least_primitive_root(s64 const n, prime_factorization const &f) -> s64;
+
+        } // namespace impl_details
+
+        /** \struct modulus_traits<N>
+            \brief Facts about the modulus N, for algorithms to pick specialised paths without any runtime cost.
+            \details N is factored at compile time, by trial division and then Pollard's rho, so even a product of
+                     two primes near \f$2^{31}\f$ is handled, though it takes the compiler a moment. Without
+                     MATH_NERD_INT_MOD_HAS_INT128 such hard composites near \f$2^{63}\f$ may exceed the compiler's
+                     constexpr step limit. Nothing is computed unless modulus_traits<N> is used.
+         */
+        template <s64 N>
+        struct modulus_traits
+        {
+            static_assert(N > 1, "Modulus N of modulus_traits<N> must be at least 2.");
+
+        private:
+            /** \property static constexpr impl_details::prime_factorization factorization_
+                \brief The factorisation of N.
+             */
+            static constexpr impl_details::prime_factorization factorization_{ impl_details::factorize_fixed(N) };
+
+        public:
+            /** \property static constexpr int factor_count
+                \brief Number of distinct primes dividing N.
+             */
+            static constexpr int factor_count{ factorization_.count };
+
+            /** \property static constexpr bool is_prime
+                \brief True if N is prime.
+             */
+            static constexpr bool is_prime{ factor_count == 1 && factorization_.factors[0].second == 1 };
+
+            /** \property static constexpr s64 phi
+                \brief Euler's totient: the number of units modulo N.
+             */
+            static constexpr s64 phi{ []
+            {
+                s64 result{ N };
+
+                for( int i{ 0 }; i < factor_count; ++i )
+                {
+                    result -= result / factorization_.factors[static_cast<std::size_t>(i)].first;
+                }
+
+                return result;
+            }() };
+
+            /** \property static constexpr s64 carmichael
+                \brief Carmichael's lambda: the least exponent e with \f$a^e = 1\f$ for every unit a. It divides phi.
+             */
+            static constexpr s64 carmichael{ impl_details::carmichael_of(factorization_) };
+
+            /** \property static constexpr s64 primitive_root
+                \brief Least generator of the units modulo N, or 0 if they are not cyclic. N = 2 gives 1.
+             */
+            static constexpr s64 primitive_root{ N == 2 ? 1 : impl_details::least_primitive_root(N, factorization_) };
+
+            /** \property static constexpr int two_adicity
+                \brief Largest k with \f$2^k \mid N - 1\f$.
+             */
+            static constexpr int two_adicity{ std::countr_zero(static_cast<u64>(N - 1)) };
+
+            /** \fn static constexpr auto factors() noexcept -> std::span<std::pair<s64, int> const>
+                \brief Returns the factorisation of N as (prime, exponent) pairs in increasing order of prime.
+             */
+            static constexpr auto factors() noexcept -> std::span<std::pair<s64, int> const>
+            {
+                return { factorization_.factors.data(), static_cast<std::size_t>(factor_count) };
+            }
+        };
+
+        // Implementation function definitions.
+        namespace impl_details
+        {
+            constexpr auto pollard_rho(u64 const n) -> u64
+            {
+                for( u64 c{ 1 }; ; ++c )
+                {
+                    auto const f = [n, c](u64 x) { return (mul_mod(x, x, n) + c) % n; };
+
+                    u64 x{ 2 };
+                    u64 y{ 2 };
+                    u64 g{ 1 };
+                    u64 q{ 1 };
+                    u64 saved{ 2 };
+
+                    for( u64 r{ 1 }; g == 1; r *= 2 )
+                    {
+                        x = y;
+
+                        for( u64 i{ 0 }; i < r; ++i )
+                        {
+                            y = f(y);
+                        }
+
+                        for( u64 k{ 0 }; k < r && g == 1; k += 128 )
+                        {   // Batch the gcd: multiply |x - y| into q for up to 128 steps before taking it.
+                            saved = y;
+
+                            for( u64 i{ 0 }; i < 128 && i < r - k; ++i )
+                            {
+                                y = f(y);
+                                q = mul_mod(q, x > y ? x - y : y - x, n);
+                            }
+
+                            g = static_cast<u64>(gcd(static_cast<s64>(q), static_cast<s64>(n)));
+                        }
+                    }
+
+                    if( g == n )
+                    {   // The batch overshot; step one at a time from the last checkpoint.
+                        do
+                        {
+                            saved = f(saved);
+                            g = static_cast<u64>(gcd(static_cast<s64>(x > saved ? x - saved : saved - x), static_cast<s64>(n)));
+                        } while( g == 1 );
+                    }
+
+                    if( g != n )
+                    {
+                        return g;
+                    }
+                }
+            }
+
+            constexpr auto factorize(s64 n) -> std::vector<std::pair<s64, int>>
+            {
+                std::vector<std::pair<s64, int>> factors;
+
+                auto const divide_out = [&factors, &n](s64 p)
+                {
+                    if( n % p == 0 )
+                    {
+                        int k{ 0 };
+
+                        while( n % p == 0 )
+                        {
+                            n /= p;
+                            ++k;
+                        }
+
+                        factors.emplace_back(p, k);
+                    }
+                };
+
+                for( s64 p{ 2 }; p < 64 && p <= n / p; ++p )
+                {
+                    divide_out(p);
+                }
+
+                std::vector<s64> stack;
+                if( n > 1 )
+                {
+                    stack.push_back(n);
+                }
+
+                std::vector<s64> primes;
+
+                while( !stack.empty() )
+                {
+                    s64 const m{ stack.back() };
+                    stack.pop_back();
+
+                    if( m < 64 * 64 || is_prime(static_cast<u64>(m)) )
+                    {   // Everything below 64^2 left after trial division is prime.
+                        primes.push_back(m);
+                        continue;
+                    }
+
+                    s64 const d{ static_cast<s64>(pollard_rho(static_cast<u64>(m))) };
+                    stack.push_back(d);
+                    stack.push_back(m / d);
+                }
+
+                std::sort(primes.begin(), primes.end());
+
+                for( auto const p : primes )
+                {
+                    if( !factors.empty() && factors.back().first == p )
+                    {
+                        ++factors.back().second;
+                    }
+                    else
+                    {
+                        factors.emplace_back(p, 1);
+                    }
+                }
+
+                std::sort(factors.begin(), factors.end());
+
+                return factors;
+            }
+
+            constexpr auto factorize_fixed(s64 const n) -> prime_factorization
+            {
+                prime_factorization result;
+
+                for( auto const &factor : factorize(n) )
+                {
+                    result.factors[static_cast<std::size_t>(result.count++)] = factor;
+                }
+
+                return result;
+            }
+
+            constexpr auto carmichael_of(prime_factorization const &f) noexcept -> s64
+            {
+                s64 result{ 1 };
+
+                for( int i{ 0 }; i < f.count; ++i )
+                {
+                    auto const [p, k] = f.factors[static_cast<std::size_t>(i)];
+
+                    s64 lambda{ p - 1 };
+
+                    for( int j{ 1 }; j < k; ++j )
+                    {
+                        lambda *= p;
+                    }
+
+                    if( p == 2 && k >= 3 )
+                    {   // The units modulo 2^k are not cyclic from k = 3 on; their exponent is half of phi.
+                        lambda /= 2;
+                    }
+
+                    result = result / gcd(result, lambda) * lambda;
+                }
+
+                return result;
+            }
+
+            constexpr auto least_primitive_root(s64 const n, prime_factorization const &f) -> s64
+            {
+                auto const [p, k] = f.factors[static_cast<std::size_t>(f.count - 1)];
+                bool const cyclic{ n == 4 || (p != 2 && (f.count == 1 || (f.count == 2 && f.factors[0] == std::pair<s64, int>{ 2, 1 }))) };
+
+                if( !cyclic )
+                {
+                    return 0;
+                }
+
+                // The unit group has order phi(n) = p^(k-1) (p - 1) (times 1 for the factor 2), and g generates it
+                // iff g^(phi / q) != 1 for every prime q dividing phi.
+                s64 phi{ p - 1 };
+
+                for( int j{ 1 }; j < k; ++j )
+                {
+                    phi *= p;
+                }
+
+                std::vector<s64> divisors;
+
+                if( k > 1 )
+                {
+                    divisors.push_back(p);
+                }
+
+                for( auto const &[q, e] : factorize(p - 1) )
+                {
+                    divisors.push_back(q);
+                }
+
+                for( s64 g{ 2 }; g < n; ++g )
+                {
+                    if( gcd(g, n) != 1 )
+                    {
+                        continue;
+                    }
+
+                    bool primitive{ true };
+
+                    for( auto const q : divisors )
+                    {
+                        if( pow_mod(static_cast<u64>(g), static_cast<u64>(phi / q), static_cast<u64>(n)) == 1 )
+                        {
+                            primitive = false;
+                            break;
+                        }
+                    }
+
+                    if( primitive )
+                    {
+                        return g;
+                    }
+                }
+
+                return 0;
+            }
+
+        } // namespace impl_details
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -0,0 +1,575 @@
+#pragma once
+#ifndef MATH_NERD_MONTGOMERY_INT_MOD_H
+#define MATH_NERD_MONTGOMERY_INT_MOD_H
+
+/** \file montgomery_int_mod.h
+    \brief Montgomery-form counterpart of int_mod<N> for division-free multiplication modulo odd N.
+ */
+#include <optional>
+#include <type_traits>
+
+#include "int_mod.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        namespace impl_details
+        {
+            /** \class montgomery_params<N>
+                \brief Compile-time constants for Montgomery reduction modulo N.
+                \details Uses \f$R = 2^{32}\f$ with 32-bit storage when \f$N < 2^{31}\f$, and \f$R = 2^{64}\f$ with
+                         64-bit storage and 128-bit products otherwise.
+             */
+            template <s64 N>
+            struct montgomery_params
+            {
+                static_assert(N % 2 == 1, "Montgomery form requires an odd modulus N.");
+
+                /** \property static constexpr bool narrow
+                    \brief True if \f$R = 2^{32}\f$ suffices, i.e. \f$N < 2^{31}\f$.
+                 */
+                static constexpr bool narrow{ N < (s64{ 1 } << 31) };
+
+#if !defined(MATH_NERD_INT_MOD_HAS_INT128)
+                static_assert(narrow, "Montgomery form with N >= 2^31 requires a 128-bit integer type.");
+
+                using word = u32;
+                using dword = u64;
+#else
+                /** \name Storage type for residues in Montgomery form.
+                 */
+                using word = std::conditional_t<narrow, u32, u64>;
+
+                /** \name Type wide enough to hold the product of two words.
+                 */
+                using dword = std::conditional_t<narrow, u64, u128>;
+#endif
+
+                /** \property static constexpr int bits
+                    \brief \f$\log_2 R\f$.
+                 */
+                static constexpr int bits{ std::numeric_limits<word>::digits };
+
+                /** \fn static constexpr auto compute_n_prime() noexcept -> word
+                    \brief Computes \f$N' = -N^{-1}\ \left(\mathrm{mod}\ R\right)\f$ by Newton iteration.
+                           Each step doubles the number of correct low bits, starting from 3 (N is odd).
+                 */
+                static constexpr auto compute_n_prime() noexcept -> word
+                {
+                    word inv{ static_cast<word>(N) };
+
+                    for( auto i{ 3 }; i < bits; i *= 2 )
+                    {
+                        inv *= static_cast<word>(2u - static_cast<word>(N) * inv);
+                    }
+
+                    return static_cast<word>(0u - inv);
+                }
+
+                /** \property static constexpr word n_prime
+                    \brief \f$-N^{-1}\f$ modulo R.
+                 */
+                static constexpr word n_prime{ compute_n_prime() };
+
+                /** \property static constexpr word r
+                    \brief R modulo N, i.e. the Montgomery form of 1.
+                 */
+                static constexpr word r{ static_cast<word>((dword{ 1 } << bits) % static_cast<dword>(N)) };
+
+                /** \property static constexpr word r2
+                    \brief \f$R^2\f$ modulo N, used to convert into Montgomery form.
+                 */
+                static constexpr word r2{ static_cast<word>((dword{ r } * r) % static_cast<dword>(N)) };
+
+                /** \fn static constexpr auto reduce(dword t) noexcept -> word
+                    \brief REDC: returns \f$tR^{-1}\f$ modulo N for \f$0 \le t < NR\f$ using only multiplications and a shift.
+                 */
+                static constexpr auto reduce(dword t) noexcept -> word
+                {
+                    word const m{ static_cast<word>(static_cast<word>(t) * n_prime) };
+                    dword const res{ (t + dword{ m } * static_cast<dword>(N)) >> bits };
+
+                    return static_cast<word>(res >= static_cast<dword>(N) ? res - static_cast<dword>(N) : res);
+                }
+
+                /** \fn static constexpr auto to_form(s64 n) noexcept -> word
+                    \brief Converts a standard form residue into Montgomery form.
+                 */
+                static constexpr auto to_form(s64 n) noexcept -> word
+                {
+                    return reduce(static_cast<dword>(n) * r2);
+                }
+
+                /** \fn static constexpr auto from_form(word n) noexcept -> s64
+                    \brief Converts a Montgomery form residue back into standard form.
+                 */
+                static constexpr auto from_form(word n) noexcept -> s64
+                {
+                    return static_cast<s64>(reduce(n));
+                }
+            };
+
+        } // namespace impl_details
+
+        /** \class montgomery_int_mod<N>
+            \brief Integer modulo odd N stored in Montgomery form.
+            \details Values are converted into Montgomery form at construction and back out at value(), so chains of
+                     multiplications and pow() never perform a hardware division.
+         */
+        template <s64 N>
+        class montgomery_int_mod
+        {
+            static_assert(N > 1, "Modulus N of montgomery_int_mod<N> must be at least 2.");
+
+            using params = impl_details::montgomery_params<N>;
+
+        private:
+            /** \property typename impl_details::montgomery_params<N>::word element_
+                \brief The stored value in Montgomery form. Default initializes to 0.
+             */
+            typename params::word element_{ 0 };
+
+        public:
+            constexpr montgomery_int_mod() = default;
+
+            constexpr montgomery_int_mod(s64 num) noexcept
+            {
+                element_ = params::to_form(impl_details::standard_modulo<N>(num));
+            }
+
+            template <typename Reduction>
+            constexpr montgomery_int_mod(int_mod<N, Reduction> const num) noexcept
+            {
+                element_ = params::to_form(num.value());
+            }
+
+            /** \fn constexpr auto modulus() const noexcept -> s64
+                \brief Returns the modulus N.
+             */
+            constexpr auto modulus() const noexcept -> s64
+            {
+                return N;
+            }
+
+            /** \fn constexpr auto value() const noexcept -> s64
+                \brief Returns the stored value in standard form.
+             */
+            constexpr auto value() const noexcept -> s64
+            {
+                return params::from_form(element_);
+            }
+
+            /** \fn constexpr auto inverse() const -> s64
+                \brief Returns the inverse modulo N of the stored value. Throws std::invalid_argument if not invertible.
+             */
+            constexpr auto inverse() const -> s64
+            {
+                return impl_details::inverse_of<N>(value());
+            }
+
+            /** \fn constexpr auto try_inverse() const noexcept -> std::optional<montgomery_int_mod<N>>
+                \brief Returns the inverse modulo N of the stored value, or std::nullopt if not invertible.
+             */
+            constexpr auto try_inverse() const noexcept -> std::optional<montgomery_int_mod<N>>;
+
+            /** \fn constexpr auto checked_div(montgomery_int_mod<N> const rhs) const noexcept -> std::optional<montgomery_int_mod<N>>
+                \brief Returns *this divided by rhs, or std::nullopt if rhs is not invertible.
+             */
+            constexpr auto checked_div(montgomery_int_mod<N> const rhs) const noexcept -> std::optional<montgomery_int_mod<N>>;
+
+            /** \fn constexpr auto pow(s64 exponent) const -> montgomery_int_mod<N>
+                \brief Returns the stored value raised to exponent using left-to-right square-and-multiply in Montgomery form.
+                       Throws std::invalid_argument if exponent is negative.
+             */
+            constexpr auto pow(s64 exponent) const -> montgomery_int_mod<N>;
+
+            /** \fn constexpr auto pow() const noexcept -> montgomery_int_mod<N>
+                \brief Returns the stored value raised to the compile-time exponent E with a fully unrolled multiplication chain.
+             */
+            template <s64 E>
+            constexpr auto pow() const noexcept -> montgomery_int_mod<N>
+            {
+                static_assert(E >= 0, "Exponent E of montgomery_int_mod<N>::pow<E>() must be non-negative.");
+
+                return impl_details::pow_unrolled<static_cast<u64>(E)>(*this, montgomery_int_mod<N>{ 1 });
+            }
+
+            /** \fn constexpr explicit operator s64() const
+                \brief Explicit type conversion back to a signed 64-bit integer.
+             */
+            constexpr explicit operator s64() const
+            {
+                return value();
+            }
+
+            /** \fn constexpr explicit operator int_mod<N>() const
+                \brief Explicit type conversion back to int_mod<N>.
+             */
+            constexpr explicit operator int_mod<N>() const
+            {
+                return value();
+            }
+
+            /** \name Increment/Decrement operators */
+            /** \fn constexpr auto operator++() noexcept -> montgomery_int_mod<N> &
+                \brief Pre-increments the stored value modulo N.
+             */
+            constexpr auto operator++() noexcept -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator++(int) noexcept -> montgomery_int_mod<N>
+                \brief Post-increments the stored value modulo N.
+             */
+            constexpr auto operator++(int) noexcept -> montgomery_int_mod<N>;
+
+            /** \fn constexpr auto operator--() noexcept -> montgomery_int_mod<N> &
+                \brief Pre-decrements the stored value modulo N.
+             */
+            constexpr auto operator--() noexcept -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator--(int) noexcept -> montgomery_int_mod<N>
+                \brief Post-decrements the stored value modulo N.
+             */
+            constexpr auto operator--(int) noexcept -> montgomery_int_mod<N>;
+
+            /** \name Unary operators */
+            /** \fn constexpr auto operator+() const noexcept -> montgomery_int_mod<N>
+                \brief Returns the *this.
+             */
+            constexpr auto operator+() const noexcept -> montgomery_int_mod<N>;
+
+            /** \fn constexpr auto operator-() const noexcept -> montgomery_int_mod<N>
+                \brief Returns the additive inverse modulo N.
+             */
+            constexpr auto operator-() const noexcept -> montgomery_int_mod<N>;
+
+            /** \name Assignment operators */
+            /** \fn constexpr auto operator+=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+                \brief Adds rhs with a conditional subtraction instead of a remainder.
+             */
+            constexpr auto operator+=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator-=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+                \brief Subtracts rhs with a conditional addition instead of a remainder.
+             */
+            constexpr auto operator-=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator*=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+                \brief Multiplies by rhs using Montgomery reduction.
+             */
+            constexpr auto operator*=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator/=(montgomery_int_mod<N> const rhs) -> montgomery_int_mod<N> &
+                \brief Divides by rhs, if invertible modulo N. Throws std::invalid_argument if rhs is not invertible.
+             */
+            constexpr auto operator/=(montgomery_int_mod<N> const rhs) -> montgomery_int_mod<N> &;
+
+            /** \fn constexpr auto operator==(montgomery_int_mod<N> const rhs) const noexcept -> bool
+                \brief Compares the values and returns true if equal.
+             */
+            constexpr auto operator==(montgomery_int_mod<N> const rhs) const noexcept -> bool
+            {
+                return element_ == rhs.element_;
+            }
+
+            /** \fn constexpr auto operator!=(montgomery_int_mod<N> const rhs) const noexcept -> bool
+                \brief Compares the values and returns false if equal.
+             */
+            constexpr auto operator!=(montgomery_int_mod<N> const rhs) const noexcept -> bool
+            {
+                return element_ != rhs.element_;
+            }
+
+            /** \fn constexpr auto operator==(s64 rhs) const noexcept -> bool
+                \brief Compares the values and returns true if equal.
+             */
+            constexpr auto operator==(s64 rhs) const noexcept -> bool
+            {
+                return value() == impl_details::standard_modulo<N>(rhs);
+            }
+
+            /** \fn constexpr auto operator!=(s64 rhs) const noexcept -> bool
+                \brief Compares the values and returns false if equal.
+             */
+            constexpr auto operator!=(s64 rhs) const noexcept -> bool
+            {
+                return value() != impl_details::standard_modulo<N>(rhs);
+            }
+        };
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::pow(s64 exponent) const -> montgomery_int_mod<N>
+        {
+            if( exponent < 0 )
+            {
+                throw std::invalid_argument{ "Exponent must be non-negative." };
+            }
+
+            return impl_details::pow_binary(*this, montgomery_int_mod<N>{ 1 }, static_cast<u64>(exponent));
+        }
+
+        // Increment/Decrement Operators
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator++() noexcept -> montgomery_int_mod<N> &
+        {
+            return *this += montgomery_int_mod<N>{ 1 };
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator++(int) noexcept -> montgomery_int_mod<N>
+        {
+            montgomery_int_mod<N> tmp(*this);
+            operator++();
+            return tmp;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator--() noexcept -> montgomery_int_mod<N> &
+        {
+            return *this -= montgomery_int_mod<N>{ 1 };
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator--(int) noexcept -> montgomery_int_mod<N>
+        {
+            montgomery_int_mod<N> tmp(*this);
+            operator--();
+            return tmp;
+        }
+
+        // Unary operators
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator+() const noexcept -> montgomery_int_mod<N>
+        {
+            return *this;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator-() const noexcept -> montgomery_int_mod<N>
+        {
+            montgomery_int_mod<N> res{};
+            res -= *this;
+            return res;
+        }
+
+        // Assignment operators
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator+=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+        {
+            element_ += rhs.element_;
+
+            if( element_ >= static_cast<typename params::word>(N) )
+            {
+                element_ -= static_cast<typename params::word>(N);
+            }
+
+            return *this;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator-=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+        {
+            if( rhs.element_ > element_ )
+            {
+                element_ += static_cast<typename params::word>(N);
+            }
+
+            element_ -= rhs.element_;
+
+            return *this;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator*=(montgomery_int_mod<N> const rhs) noexcept -> montgomery_int_mod<N> &
+        {
+            element_ = params::reduce(static_cast<typename params::dword>(element_) * rhs.element_);
+
+            return *this;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::try_inverse() const noexcept -> std::optional<montgomery_int_mod<N>>
+        {
+            if( auto const inv = impl_details::try_inverse_of<N>(value()) )
+            {
+                return montgomery_int_mod<N>{ *inv };
+            }
+
+            return std::nullopt;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::checked_div(montgomery_int_mod<N> const rhs) const noexcept -> std::optional<montgomery_int_mod<N>>
+        {
+            if( auto const inv = rhs.try_inverse() )
+            {
+                return *this * *inv;
+            }
+
+            return std::nullopt;
+        }
+
+        template <s64 N>
+        constexpr auto montgomery_int_mod<N>::operator/=(montgomery_int_mod<N> const rhs) -> montgomery_int_mod<N> &
+        {
+            *this *= montgomery_int_mod<N>{ rhs.inverse() };
+
+            return *this;
+        }
+
+        /** \name Arithmetic operators. */
+        /** \fn constexpr auto operator+(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of adding two montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator+(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs += rhs;
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator-(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of subtracting two montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator-(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs -= rhs;
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator*(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of multiplying two montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator*(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs *= rhs;
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator/(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) -> montgomery_int_mod<N>
+            \brief Returns the result of dividing two montgomery_int_mod<N>. Throws std::invalid_argument if rhs is not invertible.
+         */
+        template <s64 N>
+        constexpr auto operator/(montgomery_int_mod<N> lhs, montgomery_int_mod<N> rhs) -> montgomery_int_mod<N>
+        {
+            lhs /= rhs;
+
+            return lhs;
+        }
+
+        // Right-s64 versions
+        /** \fn constexpr auto operator+(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of adding montgomery_int_mod<N> and s64.
+         */
+        template <s64 N>
+        constexpr auto operator+(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs += montgomery_int_mod<N>{ rhs };
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator-(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of subtracting montgomery_int_mod<N> and s64.
+         */
+        template <s64 N>
+        constexpr auto operator-(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs -= montgomery_int_mod<N>{ rhs };
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator*(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of multiplying montgomery_int_mod<N> and s64.
+         */
+        template <s64 N>
+        constexpr auto operator*(montgomery_int_mod<N> lhs, s64 rhs) noexcept -> montgomery_int_mod<N>
+        {
+            lhs *= montgomery_int_mod<N>{ rhs };
+            return lhs;
+        }
+
+        /** \fn constexpr auto operator/(montgomery_int_mod<N> lhs, s64 rhs) -> montgomery_int_mod<N>
+            \brief Returns the result of dividing montgomery_int_mod<N> and s64. Throws std::invalid_argument if rhs is not invertible.
+         */
+        template <s64 N>
+        constexpr auto operator/(montgomery_int_mod<N> lhs, s64 rhs) -> montgomery_int_mod<N>
+        {
+            lhs /= montgomery_int_mod<N>{ rhs };
+            return lhs;
+        }
+
+        // Left-s64 versions
+        /** \fn constexpr auto operator+(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of adding s64 and montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator+(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            return montgomery_int_mod<N>{ lhs } + rhs;
+        }
+
+        /** \fn constexpr auto operator-(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of subtracting s64 and montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator-(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            return montgomery_int_mod<N>{ lhs } - rhs;
+        }
+
+        /** \fn constexpr auto operator*(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+            \brief Returns the result of multiplying s64 and montgomery_int_mod<N>.
+         */
+        template <s64 N>
+        constexpr auto operator*(s64 const lhs, montgomery_int_mod<N> rhs) noexcept -> montgomery_int_mod<N>
+        {
+            return montgomery_int_mod<N>{ lhs } * rhs;
+        }
+
+        /** \fn constexpr auto operator/(s64 const lhs, montgomery_int_mod<N> rhs) -> montgomery_int_mod<N>
+            \brief Returns the result of dividing s64 and montgomery_int_mod<N>. Throws std::invalid_argument if rhs is not invertible.
+         */
+        template <s64 N>
+        constexpr auto operator/(s64 const lhs, montgomery_int_mod<N> rhs) -> montgomery_int_mod<N>
+        {
+            return montgomery_int_mod<N>{ lhs } / rhs;
+        }
+
+        // I/O operators
+        /** \fn constexpr auto operator<<(std::ostream &os, montgomery_int_mod<N> const &rhs) -> std::ostream &
+            \brief Outputs our number in standard form. Returns the ostream object for further output.
+         */
+        template <s64 N>
+        constexpr auto operator<<(std::ostream &os, montgomery_int_mod<N> const &rhs) -> std::ostream &
+        {
+            os << rhs.value();
+            return os;
+        }
+
+        /** \fn constexpr auto operator>>(std::istream &is, montgomery_int_mod<N> &rhs) -> std::istream &
+            \brief Inputs our number in standard form. Returns the istream object for further input.
+         */
+        template <s64 N>
+        constexpr auto operator>>(std::istream &is, montgomery_int_mod<N> &rhs) -> std::istream &
+        {
+            s64 tmp;
+            is >> tmp;
+
+            rhs = montgomery_int_mod<N>{ tmp };
+
+            return is;
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -0,0 +1,395 @@
+#pragma once
+#ifndef MATH_NERD_NTT_H
+#define MATH_NERD_NTT_H
+
+/** \file ntt.h
+    \brief Number theoretic transform over int_mod<N> for primes N with large power-of-two roots of unity.
+ */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+#include "modulus_traits.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \struct ntt_traits<N>
+            \brief Roots of unity for the number theoretic transform modulo N, all computed at compile time.
+            \details A thin view of modulus_traits<N> restricted to odd primes, the only moduli the transform supports.
+         */
+        template <s64 N>
+        struct ntt_traits
+        {
+            /** \property static constexpr s64 primitive_root
+                \brief Least primitive root modulo N, or 0 if N is not prime.
+             */
+            static constexpr s64 primitive_root{ N > 2 && modulus_traits<N>::is_prime ? modulus_traits<N>::primitive_root : 0 };
+
+            /** \property static constexpr int max_log_size
+                \brief Largest k with \f$2^k \mid N - 1\f$, so transforms of up to \f$2^k\f$ points are possible.
+             */
+            static constexpr int max_log_size{ modulus_traits<N>::two_adicity };
+
+            /** \fn static constexpr auto root_of_unity(int const log_size) noexcept -> s64
+                \brief Returns the principal \f$2^{log\_size}\f$-th root of unity \f$g^{(N-1)/2^{log\_size}}\f$.
+             */
+            static constexpr auto root_of_unity(int const log_size) noexcept -> s64
+            {
+                return static_cast<s64>(impl_details::pow_mod(static_cast<u64>(primitive_root), static_cast<u64>(N - 1) >> log_size, static_cast<u64>(N)));
+            }
+        };
+
+        /** \class ntt_plan<N, Reduction>
+            \brief Forward and inverse number theoretic transforms of one power-of-two size.
+            \details The forward transform maps \f$a\f$ to \f$\hat{a}_k = \sum_j a_j \omega^{jk}\f$, where \f$\omega\f$ is
+                     ntt_traits<N>::root_of_unity(log2(size)); the inverse undoes it, including the division by size.
+                     Both take and return values in natural order. The constructor lays the twiddle factors out
+                     stage by stage in the order the radix-4 decimation-in-frequency kernel reads them, so every stage
+                     streams through its own contiguous slice. A leading radix-2 stage handles odd powers of two.
+                     N must be prime; this is checked at compile time.
+         */
+        template <s64 N, typename Reduction = remainder_reduction>
+        class ntt_plan
+        {
+            static_assert(ntt_traits<N>::primitive_root != 0, "ntt_plan<N> requires a prime modulus N.");
+            static_assert(ntt_traits<N>::max_log_size >= 1, "ntt_plan<N> requires N - 1 to be even.");
+
+        public:
+            /** \typedef value_type
+                \brief The element type the plan transforms.
+             */
+            using value_type = int_mod<N, Reduction>;
+
+            /** \typedef twiddle_type
+                \brief How the fixed factors of the butterflies are stored.
+             */
+            using twiddle_type = fixed_multiplier<N, Reduction>;
+
+        private:
+            /** \property std::size_t size_
+                \brief Number of points.
+             */
+            std::size_t size_;
+
+            /** \property int log_size_
+                \brief Base-2 logarithm of size_.
+             */
+            int log_size_;
+
+            /** \property std::vector<twiddle_type> forward_twiddles_
+                \brief Twiddle factors of the forward transform, in kernel order.
+             */
+            std::vector<twiddle_type> forward_twiddles_;
+
+            /** \property std::vector<twiddle_type> inverse_twiddles_
+                \brief Twiddle factors of the inverse transform, in kernel order.
+             */
+            std::vector<twiddle_type> inverse_twiddles_;
+
+            /** \property twiddle_type forward_imag_
+                \brief Primitive 4th root of unity used by the forward radix-4 butterflies.
+             */
+            twiddle_type forward_imag_;
+
+            /** \property twiddle_type inverse_imag_
+                \brief Inverse of forward_imag_.
+             */
+            twiddle_type inverse_imag_;
+
+            /** \property twiddle_type size_inverse_
+                \brief Inverse of size_ modulo N.
+             */
+            twiddle_type size_inverse_;
+
+            /** \fn static auto build_twiddles(value_type const root, int const log_size) -> std::vector<twiddle_type>
+                \brief Lays out the twiddle factors for a primitive \f$2^{log\_size}\f$-th root of unity.
+             */
+            static auto build_twiddles(value_type const root, int const log_size) -> std::vector<twiddle_type>;
+
+            /** \fn auto transform(std::span<value_type> const values, std::vector<twiddle_type> const &twiddles, twiddle_type const imag) const -> void
+                \brief Decimation-in-frequency transform in place; the result is left in bit-reversed order.
+             */
+            auto transform(std::span<value_type> const values, std::vector<twiddle_type> const &twiddles,
+                           twiddle_type const imag) const -> void;
+
+            /** \fn auto bit_reverse(std::span<value_type> const values) const -> void
+                \brief Applies the bit-reversal permutation in place.
+             */
+            auto bit_reverse(std::span<value_type> const values) const -> void;
+
+            /** \fn auto check_size(std::size_t const size) const -> void
+                \brief Throws std::invalid_argument unless size matches the plan.
+             */
+            auto check_size(std::size_t const size) const -> void;
+
+        public:
+            /** \fn explicit ntt_plan(std::size_t const size)
+                \brief Precomputes the twiddle factors for size points. Throws std::invalid_argument unless size is a
+                       power of two no larger than max_size().
+             */
+            explicit ntt_plan(std::size_t const size);
+
+            /** \fn static constexpr auto max_size() noexcept -> std::size_t
+                \brief Returns the largest transform size modulo N.
+             */
+            static constexpr auto max_size() noexcept -> std::size_t
+            {
+                return std::size_t{ 1 } << ntt_traits<N>::max_log_size;
+            }
+
+            /** \fn auto size() const noexcept -> std::size_t
+                \brief Returns the number of points.
+             */
+            auto size() const noexcept -> std::size_t
+            {
+                return size_;
+            }
+
+            /** \fn auto forward(std::span<value_type> const values) const -> void
+                \brief Transforms values in place. Throws std::invalid_argument if values.size() != size().
+             */
+            auto forward(std::span<value_type> const values) const -> void;
+
+            /** \fn auto forward(std::span<value_type const> const input, std::span<value_type> const output) const -> void
+                \brief Writes the transform of input to output. Throws std::invalid_argument if either size differs from size().
+             */
+            auto forward(std::span<value_type const> const input, std::span<value_type> const output) const -> void;
+
+            /** \fn auto inverse(std::span<value_type> const values) const -> void
+                \brief Inverse-transforms values in place. Throws std::invalid_argument if values.size() != size().
+             */
+            auto inverse(std::span<value_type> const values) const -> void;
+
+            /** \fn auto inverse(std::span<value_type const> const input, std::span<value_type> const output) const -> void
+                \brief Writes the inverse transform of input to output. Throws std::invalid_argument if either size differs from size().
+             */
+            auto inverse(std::span<value_type const> const input, std::span<value_type> const output) const -> void;
+        };
+
+        template <s64 N, typename Reduction>
+        ntt_plan<N, Reduction>::ntt_plan(std::size_t const size)
+            : size_{ size }, log_size_{ std::countr_zero(size) }
+        {
+            if( !std::has_single_bit(size) || size > max_size() )
+            {
+                throw std::invalid_argument("NTT size " + std::to_string(size) + " must be a power of two no larger than 2^"
+                    + std::to_string(ntt_traits<N>::max_log_size) + " modulo " + std::to_string(N) + ".\n");
+            }
+
+            value_type const root{ ntt_traits<N>::root_of_unity(log_size_) };
+            value_type const root_inverse{ root.inverse() };
+
+            forward_twiddles_ = build_twiddles(root, log_size_);
+            inverse_twiddles_ = build_twiddles(root_inverse, log_size_);
+
+            if( size_ >= 4 )
+            {
+                forward_imag_ = root.pow(static_cast<s64>(size_ / 4));
+                inverse_imag_ = root_inverse.pow(static_cast<s64>(size_ / 4));
+            }
+
+            size_inverse_ = value_type{ value_type{ static_cast<s64>(size_) }.inverse() };
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::build_twiddles(value_type const root, int const log_size) -> std::vector<twiddle_type>
+        {
+            std::size_t const size{ std::size_t{ 1 } << log_size };
+            std::vector<twiddle_type> twiddles;
+            twiddles.reserve(size + size / 2);
+
+            std::size_t block{ size };
+
+            if( log_size % 2 == 1 )
+            {   // Radix-2 stage over the whole array: w^j for j < size / 2, w = root.
+                value_type w{ 1 };
+
+                for( std::size_t j{ 0 }; j < size / 2; ++j )
+                {
+                    twiddles.push_back(w);
+                    w *= root;
+                }
+
+                block /= 2;
+            }
+
+            for( ; block >= 4; block /= 4 )
+            {   // Radix-4 stage on blocks of 4m: (w^j, w^2j, w^3j) for j < m, w a primitive 4m-th root of unity.
+                std::size_t const m{ block / 4 };
+                value_type const w{ root.pow(static_cast<s64>(size / block)) };
+                value_type wj{ 1 };
+
+                for( std::size_t j{ 0 }; j < m; ++j )
+                {
+                    value_type const w2j{ wj * wj };
+
+                    twiddles.push_back(wj);
+                    twiddles.push_back(w2j);
+                    twiddles.push_back(w2j * wj);
+                    wj *= w;
+                }
+            }
+
+            return twiddles;
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::transform(std::span<value_type> const values, std::vector<twiddle_type> const &twiddles,
+                                                twiddle_type const imag) const -> void
+        {
+            value_type *const a{ values.data() };
+            twiddle_type const *tw{ twiddles.data() };
+            std::size_t block{ size_ };
+
+            if( log_size_ % 2 == 1 )
+            {
+                std::size_t const m{ size_ / 2 };
+
+                for( std::size_t j{ 0 }; j < m; ++j )
+                {
+                    value_type const u{ a[j] };
+                    value_type const v{ a[j + m] };
+
+                    a[j] = u + v;
+                    a[j + m] = (u - v) * tw[j];
+                }
+
+                tw += m;
+                block = m;
+            }
+
+            for( ; block >= 4; block /= 4 )
+            {   // Two fused radix-2 stages: with w a primitive 4m-th root of unity and i = w^m,
+                // (a0, a1, a2, a3) -> (s + t, (s - t) w^2j, (d + e) w^j, (d - e) w^3j),
+                // where s = a0 + a2, t = a1 + a3, d = a0 - a2 and e = (a1 - a3) i.
+                std::size_t const m{ block / 4 };
+
+                for( std::size_t start{ 0 }; start < size_; start += block )
+                {
+                    value_type *const b{ a + start };
+
+                    for( std::size_t j{ 0 }; j < m; ++j )
+                    {
+                        value_type const a0{ b[j] };
+                        value_type const a1{ b[j + m] };
+                        value_type const a2{ b[j + 2 * m] };
+                        value_type const a3{ b[j + 3 * m] };
+
+                        value_type const s{ a0 + a2 };
+                        value_type const d{ a0 - a2 };
+                        value_type const t{ a1 + a3 };
+                        value_type const e{ (a1 - a3) * imag };
+
+                        b[j] = s + t;
+                        b[j + m] = (s - t) * tw[3 * j + 1];
+                        b[j + 2 * m] = (d + e) * tw[3 * j];
+                        b[j + 3 * m] = (d - e) * tw[3 * j + 2];
+                    }
+                }
+
+                tw += 3 * m;
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::bit_reverse(std::span<value_type> const values) const -> void
+        {
+            for( std::size_t i{ 1 }, j{ 0 }; i < size_; ++i )
+            {
+                std::size_t bit{ size_ >> 1 };
+
+                for( ; j & bit; bit >>= 1 )
+                {
+                    j ^= bit;
+                }
+
+                j ^= bit;
+
+                if( i < j )
+                {
+                    std::swap(values[i], values[j]);
+                }
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::check_size(std::size_t const size) const -> void
+        {
+            if( size != size_ )
+            {
+                throw std::invalid_argument("ntt_plan of size " + std::to_string(size_) + " was given "
+                    + std::to_string(size) + " values.\n");
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::forward(std::span<value_type> const values) const -> void
+        {
+            check_size(values.size());
+
+            transform(values, forward_twiddles_, forward_imag_);
+            bit_reverse(values);
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::forward(std::span<value_type const> const input, std::span<value_type> const output) const -> void
+        {
+            check_size(input.size());
+            check_size(output.size());
+
+            if( input.data() != output.data() )
+            {
+                std::copy(input.begin(), input.end(), output.begin());
+            }
+
+            forward(output);
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::inverse(std::span<value_type> const values) const -> void
+        {
+            check_size(values.size());
+
+            transform(values, inverse_twiddles_, inverse_imag_);
+            bit_reverse(values);
+
+            for( auto &x : values )
+            {
+                x *= size_inverse_;
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto ntt_plan<N, Reduction>::inverse(std::span<value_type const> const input, std::span<value_type> const output) const -> void
+        {
+            check_size(input.size());
+            check_size(output.size());
+
+            if( input.data() != output.data() )
+            {
+                std::copy(input.begin(), input.end(), output.begin());
+            }
+
+            inverse(output);
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -0,0 +1,1065 @@
+#pragma once
+#ifndef MATH_NERD_POLYNOMIAL_H
+#define MATH_NERD_POLYNOMIAL_H
+
+/** \file polynomial.h
+    \brief Dense univariate polynomials over int_mod<N> with sub-quadratic multiplication, division and evaluation.
+ */
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+#include "int_mod_accumulator.h"
+#include "ntt.h"
+#include "rns.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        /** \class polynomial<T>
+            \brief Polynomial with coefficients of type T. Only polynomial<int_mod<N, Reduction>> is defined.
+         */
+        template <typename T>
+        class polynomial;
+
+        namespace impl_details
+        {
+            /** \fn constexpr auto ntt_friendly() noexcept -> bool
+                \brief True if ntt_plan<N> exists and supports transforms of at least 2^10 points.
+             */
+            template <s64 N>
+            constexpr auto ntt_friendly() noexcept -> bool;
+
+            /** \fn auto cached_ntt_plan(int const log_size) -> ntt_plan<N, Reduction> const &
+                \brief Returns a per-thread ntt_plan of \f$2^{log\_size}\f$ points, building it on first use.
+             */
+            template <s64 N, typename Reduction>
+            auto cached_ntt_plan(int const log_size) -> ntt_plan<N, Reduction> const &;
+
+            /** \fn auto multiply_schoolbook(std::span<int_mod<N> const> const a, std::span<int_mod<N> const> const b) -> std::vector<int_mod<N>>
+                \brief Quadratic product of two non-empty coefficient sequences. Each coefficient is summed in an
+                       int_mod_accumulator, so it is reduced once per run of products rather than once per product.
+             */
+            template <s64 N, typename Reduction>
+            auto multiply_schoolbook(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b)
+                -> std::vector<int_mod<N, Reduction>>;
+
+            /** \fn auto multiply_karatsuba(std::span<T const> const a, std::span<T const> const b, std::size_t const threshold) -> std::vector<T>
+                \brief Karatsuba product of two non-empty coefficient sequences, switching to schoolbook once the
+                       shorter operand has at most threshold coefficients. Unbalanced operands are cut into
+                       balanced pieces.
+             */
+            template <typename T>
+            auto multiply_karatsuba(std::span<T const> const a, std::span<T const> const b, std::size_t const threshold) -> std::vector<T>;
+
+            /** \fn auto multiply_ntt(std::span<int_mod<N> const> const a, std::span<int_mod<N> const> const b) -> std::vector<int_mod<N>>
+                \brief Product of two non-empty coefficient sequences by cyclic convolution with ntt_plan.
+                       The product must have at most ntt_plan<N>::max_size() coefficients.
+             */
+            template <s64 N, typename Reduction>
+            auto multiply_ntt(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b)
+                -> std::vector<int_mod<N, Reduction>>;
+
+            /** \typedef three_prime_rns
+                \brief The NTT primes \f$119 \cdot 2^{23} + 1\f$, \f$5 \cdot 2^{25} + 1\f$ and \f$7 \cdot 2^{26} + 1\f$, whose
+                        product is about \f$2^{86}\f$, for convolutions modulo any other N.
+             */
+            using three_prime_rns = rns<998244353, 167772161, 469762049>;
+
+            /** \fn constexpr auto three_prime_max_terms() noexcept -> std::size_t
+                \brief Largest number of products of residues modulo N whose sum stays below the three_prime_rns
+                       modulus, capped at the largest transform all three primes support, \f$2^{23}\f$.
+                \details A coefficient of a product is a sum of at most as many terms as the shorter operand has, so this
+                         bounds the operands multiply_three_primes() can recombine exactly. The bound is a ratio of
+                         integers near \f$2^{86}\f$, computed in double with a \f$2^{-20}\f$ margin for rounding.
+             */
+            template <s64 N>
+            constexpr auto three_prime_max_terms() noexcept -> std::size_t;
+
+            /** \fn auto cyclic_convolution(std::span<S const> const a, std::span<S const> const b, ntt_plan<P, Reduction> const &plan) -> std::vector<int_mod<P, Reduction>>
+                \brief Lifts the values of a and b into int_mod<P> and returns their cyclic convolution of plan.size() points.
+             */
+            template <s64 P, typename Reduction, typename S>
+            auto cyclic_convolution(std::span<S const> const a, std::span<S const> const b, ntt_plan<P, Reduction> const &plan)
+                -> std::vector<int_mod<P, Reduction>>;
+
+            /** \fn auto multiply_three_primes(std::span<int_mod<N> const> const a, std::span<int_mod<N> const> const b, bool const parallel) -> std::vector<int_mod<N>>
+                \brief Product of two non-empty coefficient sequences modulo any N, by convolving over each prime of
+                       three_prime_rns and recombining every coefficient with Garner's algorithm.
+                \details The shorter operand must have at most three_prime_max_terms<N>() coefficients. The three
+                         convolutions are independent and run on three threads if parallel is true. Each coefficient is
+                         recovered with three_prime_rns::reduce(), which takes the mixed-radix digits modulo the 30-bit
+                         primes and sums them modulo N against prefix products of the primes computed at compile time.
+             */
+            template <s64 N, typename Reduction>
+            auto multiply_three_primes(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b,
+                                       bool const parallel) -> std::vector<int_mod<N, Reduction>>;
+
+            /** \class subproduct_tree<T>
+                \brief Balanced binary tree whose leaves are \f$x - x_i\f$ and whose inner nodes are the products of
+                       their children, used for multipoint evaluation and interpolation.
+             */
+            template <typename T>
+            class subproduct_tree;
+
+        } // namespace impl_details
+
+        template <s64 N, typename Reduction>
+        class polynomial<int_mod<N, Reduction>>
+        {
+        public:
+            /** \typedef value_type
+                \brief The coefficient type.
+             */
+            using value_type = int_mod<N, Reduction>;
+
+            /** \property static constexpr std::size_t karatsuba_threshold
+                \brief Operands with at most this many coefficients are multiplied by the schoolbook method.
+             */
+            static constexpr std::size_t karatsuba_threshold{ 32 };
+
+            /** \property static constexpr std::size_t ntt_threshold
+                \brief When N is NTT friendly, operands with at least this many coefficients are multiplied with ntt_plan.
+             */
+            static constexpr std::size_t ntt_threshold{ 64 };
+
+            /** \property static constexpr std::size_t three_prime_threshold
+                \brief When N is not NTT friendly, operands with at least this many coefficients are multiplied with
+                        impl_details::multiply_three_primes, as long as three_prime_max_terms<N>() allows it.
+                \details Measured on one core, where it beats Karatsuba from about 7400 coefficients. The three
+                         convolutions run on separate threads when the hardware has at least three, which only helps.
+             */
+            static constexpr std::size_t three_prime_threshold{ 7680 };
+
+            /** \property static constexpr std::size_t newton_threshold
+                \brief Divisions with a quotient shorter than this use long division instead of a Newton inverse.
+             */
+            static constexpr std::size_t newton_threshold{ 64 };
+
+            /** \property static constexpr std::size_t subproduct_threshold
+                \brief Multipoint evaluation switches from Horner's rule to a subproduct tree above this many points.
+             */
+            static constexpr std::size_t subproduct_threshold{ 512 };
+
+        private:
+            /** \property std::vector<value_type> coefficients_
+                \brief coefficients_[i] is the coefficient of \f$x^i\f$. The last one is non-zero; the zero polynomial is empty.
+             */
+            std::vector<value_type> coefficients_;
+
+            /** \fn auto normalize() -> void
+                \brief Removes trailing zero coefficients.
+             */
+            auto normalize() -> void;
+
+        public:
+            /** \fn polynomial()
+                \brief Constructs the zero polynomial.
+             */
+            polynomial() = default;
+
+            /** \fn polynomial(std::vector<value_type> coefficients)
+                \brief Constructs \f$\sum_i c_i x^i\f$ from coefficients in increasing degree.
+             */
+            explicit polynomial(std::vector<value_type> coefficients);
+
+            /** \fn polynomial(std::initializer_list<value_type> const coefficients)
+                \brief Constructs \f$\sum_i c_i x^i\f$ from coefficients in increasing degree.
+             */
+            polynomial(std::initializer_list<value_type> const coefficients);
+
+            /** \fn auto degree() const noexcept -> s64
+                \brief Returns the degree, or -1 for the zero polynomial.
+             */
+            auto degree() const noexcept -> s64
+            {
+                return static_cast<s64>(coefficients_.size()) - 1;
+            }
+
+            /** \fn auto size() const noexcept -> std::size_t
+                \brief Returns the number of stored coefficients, degree() + 1.
+             */
+            auto size() const noexcept -> std::size_t
+            {
+                return coefficients_.size();
+            }
+
+            /** \fn auto is_zero() const noexcept -> bool
+                \brief Returns true for the zero polynomial.
+             */
+            auto is_zero() const noexcept -> bool
+            {
+                return coefficients_.empty();
+            }
+
+            /** \fn auto coefficients() const noexcept -> std::vector<int_mod<N>> const &
+                \brief Returns the coefficients in increasing degree.
+             */
+            auto coefficients() const noexcept -> std::vector<value_type> const &
+            {
+                return coefficients_;
+            }
+
+            /** \fn auto operator[](std::size_t const i) const noexcept -> int_mod<N>
+                \brief Returns the coefficient of \f$x^i\f$, which is zero beyond the degree.
+             */
+            auto operator[](std::size_t const i) const noexcept -> value_type
+            {
+                return i < coefficients_.size() ? coefficients_[i] : value_type{ 0 };
+            }
+
+            /** \fn auto operator()(int_mod<N> const x) const noexcept -> int_mod<N>
+                \brief Evaluates the polynomial at x by Horner's rule.
+             */
+            auto operator()(value_type const x) const noexcept -> value_type;
+
+            /** \fn auto evaluate(std::span<int_mod<N> const> const points) const -> std::vector<int_mod<N>>
+                \brief Evaluates the polynomial at every point, with a subproduct tree for many points.
+             */
+            auto evaluate(std::span<value_type const> const points) const -> std::vector<value_type>;
+
+            /** \fn static auto interpolate(std::span<int_mod<N> const> const points, std::span<int_mod<N> const> const values) -> polynomial<int_mod<N>>
+                \brief Returns the polynomial of degree less than points.size() taking values[i] at points[i].
+                       Throws std::invalid_argument if the spans differ in length or a difference of two points is not invertible.
+             */
+            static auto interpolate(std::span<value_type const> const points, std::span<value_type const> const values) -> polynomial;
+
+            /** \fn auto derivative() const -> polynomial<int_mod<N>>
+                \brief Returns the formal derivative.
+             */
+            auto derivative() const -> polynomial;
+
+            /** \fn auto truncate(std::size_t const n) const -> polynomial<int_mod<N>>
+                \brief Returns the polynomial modulo \f$x^n\f$.
+             */
+            auto truncate(std::size_t const n) const -> polynomial;
+
+            /** \fn auto reverse(std::size_t const n) const -> polynomial<int_mod<N>>
+                \brief Returns \f$x^{n-1} p(1/x)\f$ for n at least size(), i.e. the first n coefficients in reverse.
+             */
+            auto reverse(std::size_t const n) const -> polynomial;
+
+            /** \fn auto inverse(std::size_t const n) const -> polynomial<int_mod<N>>
+                \brief Returns g with \f$p g \equiv 1 \pmod{x^n}\f$ by Newton iteration.
+                       Throws std::invalid_argument if the constant coefficient is not invertible.
+             */
+            auto inverse(std::size_t const n) const -> polynomial;
+
+            /** \fn auto divide(polynomial<int_mod<N>> const &divisor) const -> std::pair<polynomial<int_mod<N>>, polynomial<int_mod<N>>>
+                \brief Returns the quotient and remainder. Throws std::invalid_argument if divisor is zero or its
+                       leading coefficient is not invertible.
+                \details Short quotients use long division; longer ones multiply the reversed dividend by a Newton
+                         inverse of the reversed divisor, which costs a constant number of multiplications.
+             */
+            auto divide(polynomial const &divisor) const -> std::pair<polynomial, polynomial>;
+
+            /** \fn static auto multiply(std::span<int_mod<N> const> const a, std::span<int_mod<N> const> const b) -> std::vector<int_mod<N>>
+                \brief Product of two coefficient sequences, choosing schoolbook, Karatsuba or NTT multiplication by size.
+             */
+            static auto multiply(std::span<value_type const> const a, std::span<value_type const> const b) -> std::vector<value_type>;
+
+            /** \fn auto operator-() const -> polynomial<int_mod<N>>
+                \brief Returns the negated polynomial.
+             */
+            auto operator-() const -> polynomial;
+
+            /** \fn auto operator+=(polynomial<int_mod<N>> const &rhs) -> polynomial<int_mod<N>> &
+                \brief Adds rhs.
+             */
+            auto operator+=(polynomial const &rhs) -> polynomial &;
+
+            /** \fn auto operator-=(polynomial<int_mod<N>> const &rhs) -> polynomial<int_mod<N>> &
+                \brief Subtracts rhs.
+             */
+            auto operator-=(polynomial const &rhs) -> polynomial &;
+
+            /** \fn auto operator*=(polynomial<int_mod<N>> const &rhs) -> polynomial<int_mod<N>> &
+                \brief Multiplies by rhs.
+             */
+            auto operator*=(polynomial const &rhs) -> polynomial &;
+
+            /** \fn auto operator*=(int_mod<N> const rhs) -> polynomial<int_mod<N>> &
+                \brief Multiplies every coefficient by rhs.
+             */
+            auto operator*=(value_type const rhs) -> polynomial &;
+
+            /** \fn auto operator/=(polynomial<int_mod<N>> const &rhs) -> polynomial<int_mod<N>> &
+                \brief Replaces the polynomial by its quotient by rhs. See divide().
+             */
+            auto operator/=(polynomial const &rhs) -> polynomial &;
+
+            /** \fn auto operator%=(polynomial<int_mod<N>> const &rhs) -> polynomial<int_mod<N>> &
+                \brief Replaces the polynomial by its remainder modulo rhs. See divide().
+             */
+            auto operator%=(polynomial const &rhs) -> polynomial &;
+
+            /** \fn auto operator==(polynomial<int_mod<N>> const &rhs) const noexcept -> bool
+                \brief Returns true if both polynomials have the same coefficients.
+             */
+            auto operator==(polynomial const &rhs) const noexcept -> bool
+            {
+                return coefficients_ == rhs.coefficients_;
+            }
+
+            /** \fn auto operator!=(polynomial<int_mod<N>> const &rhs) const noexcept -> bool
+                \brief Returns true if the polynomials differ.
+             */
+            auto operator!=(polynomial const &rhs) const noexcept -> bool
+            {
+                return !(*this == rhs);
+            }
+        };
+
+        /** \fn auto operator+(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+            \brief Returns the sum of two polynomials.
+         */
+        template <typename T>
+        auto operator+(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+        {
+            return lhs += rhs;
+        }
+
+        /** \fn auto operator-(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+            \brief Returns the difference of two polynomials.
+         */
+        template <typename T>
+        auto operator-(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+        {
+            return lhs -= rhs;
+        }
+
+        /** \fn auto operator*(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+            \brief Returns the product of two polynomials.
+         */
+        template <typename T>
+        auto operator*(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+        {
+            return lhs *= rhs;
+        }
+
+        /** \fn auto operator*(polynomial<T> lhs, T const rhs) -> polynomial<T>
+            \brief Returns the polynomial scaled by rhs.
+         */
+        template <typename T>
+        auto operator*(polynomial<T> lhs, T const rhs) -> polynomial<T>
+        {
+            return lhs *= rhs;
+        }
+
+        /** \fn auto operator/(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+            \brief Returns the quotient of two polynomials.
+         */
+        template <typename T>
+        auto operator/(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+        {
+            return lhs /= rhs;
+        }
+
+        /** \fn auto operator%(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+            \brief Returns the remainder of lhs modulo rhs.
+         */
+        template <typename T>
+        auto operator%(polynomial<T> lhs, polynomial<T> const &rhs) -> polynomial<T>
+        {
+            return lhs %= rhs;
+        }
+
+        namespace impl_details
+        {
+            template <typename T>
+            class subproduct_tree
+            {
+            private:
+                /** \property std::size_t size_
+                    \brief Number of points.
+                 */
+                std::size_t size_;
+
+                /** \property std::vector<polynomial<T>> nodes_
+                    \brief Heap-ordered nodes: node 1 is the root, node k has children 2k and 2k + 1.
+                 */
+                std::vector<polynomial<T>> nodes_;
+
+                /** \property static constexpr std::size_t leaf_size
+                    \brief Ranges with at most this many points are evaluated by Horner's rule.
+                 */
+                static constexpr std::size_t leaf_size{ 16 };
+
+                /** \fn auto build(std::span<T const> const points, std::size_t const node, std::size_t const first, std::size_t const last) -> void
+                    \brief Builds the subtree for points[first, last).
+                 */
+                auto build(std::span<T const> const points, std::size_t const node, std::size_t const first, std::size_t const last) -> void;
+
+                /** \fn auto evaluate(polynomial<T> const &p, std::span<T const> const points, std::size_t const node, std::size_t const first, std::size_t const last, std::vector<T> &values) const -> void
+                    \brief Evaluates p, already reduced modulo the node, at points[first, last).
+                 */
+                auto evaluate(polynomial<T> const &p, std::span<T const> const points, std::size_t const node, std::size_t const first,
+                              std::size_t const last, std::vector<T> &values) const -> void;
+
+                /** \fn auto combine(std::span<T const> const weights, std::size_t const node, std::size_t const first, std::size_t const last) const -> polynomial<T>
+                    \brief Returns \f$\sum_i w_i M(x) / (x - x_i)\f$ over points[first, last), with M the node's product.
+                 */
+                auto combine(std::span<T const> const weights, std::size_t const node, std::size_t const first, std::size_t const last) const -> polynomial<T>;
+
+            public:
+                /** \fn explicit subproduct_tree(std::span<T const> const points)
+                    \brief Builds the tree for a non-empty set of points.
+                 */
+                explicit subproduct_tree(std::span<T const> const points);
+
+                /** \fn auto root() const noexcept -> polynomial<T> const &
+                    \brief Returns \f$\prod_i (x - x_i)\f$.
+                 */
+                auto root() const noexcept -> polynomial<T> const &
+                {
+                    return nodes_[1];
+                }
+
+                /** \fn auto evaluate(polynomial<T> const &p, std::span<T const> const points) const -> std::vector<T>
+                    \brief Evaluates p at the points the tree was built from.
+                 */
+                auto evaluate(polynomial<T> const &p, std::span<T const> const points) const -> std::vector<T>;
+
+                /** \fn auto combine(std::span<T const> const weights) const -> polynomial<T>
+                    \brief Returns \f$\sum_i w_i \prod_{j \ne i} (x - x_j)\f$.
+                 */
+                auto combine(std::span<T const> const weights) const -> polynomial<T>;
+            };
+
+            template <s64 N>
+            constexpr auto ntt_friendly() noexcept -> bool
+            {   // Check the 2-adic order first so the primitive root search only runs for plausible moduli.
+                if constexpr( std::countr_zero(static_cast<u64>(N - 1)) >= 10 )
+                {
+                    return ntt_traits<N>::primitive_root != 0;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            template <s64 N, typename Reduction>
+            auto cached_ntt_plan(int const log_size) -> ntt_plan<N, Reduction> const &
+            {
+                thread_local std::vector<std::unique_ptr<ntt_plan<N, Reduction>>> plans;
+
+                if( plans.size() <= static_cast<std::size_t>(log_size) )
+                {
+                    plans.resize(static_cast<std::size_t>(log_size) + 1);
+                }
+
+                if( !plans[log_size] )
+                {
+                    plans[log_size] = std::make_unique<ntt_plan<N, Reduction>>(std::size_t{ 1 } << log_size);
+                }
+
+                return *plans[log_size];
+            }
+
+            template <s64 N, typename Reduction>
+            auto multiply_schoolbook(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b)
+                -> std::vector<int_mod<N, Reduction>>
+            {
+                std::vector<int_mod<N, Reduction>> result(a.size() + b.size() - 1);
+
+                for( std::size_t k{ 0 }; k < result.size(); ++k )
+                {
+                    std::size_t const first{ k < b.size() ? 0 : k - b.size() + 1 };
+                    std::size_t const last{ std::min(k, a.size() - 1) };
+
+                    int_mod_accumulator<N, Reduction> sum;
+
+                    for( std::size_t i{ first }; i <= last; ++i )
+                    {
+                        sum.add_product(a[i], b[k - i]);
+                    }
+
+                    result[k] = sum.value();
+                }
+
+                return result;
+            }
+
+            template <typename T>
+            auto multiply_karatsuba(std::span<T const> a, std::span<T const> b, std::size_t const threshold) -> std::vector<T>
+            {
+                if( a.size() < b.size() )
+                {
+                    std::swap(a, b);
+                }
+
+                if( b.size() <= threshold )
+                {
+                    return multiply_schoolbook(a, b);
+                }
+
+                std::vector<T> result(a.size() + b.size() - 1);
+
+                if( a.size() >= 2 * b.size() )
+                {   // Cut a into pieces as long as b and multiply each piece in balance.
+                    for( std::size_t offset{ 0 }; offset < a.size(); offset += b.size() )
+                    {
+                        auto const piece = multiply_karatsuba(a.subspan(offset, std::min(b.size(), a.size() - offset)), b, threshold);
+
+                        for( std::size_t i{ 0 }; i < piece.size(); ++i )
+                        {
+                            result[offset + i] += piece[i];
+                        }
+                    }
+
+                    return result;
+                }
+
+                // a = a0 + a1 x^h, b = b0 + b1 x^h with b1 non-empty because b.size() > a.size() / 2 >= h.
+                std::size_t const h{ a.size() / 2 };
+                auto const a0 = a.first(h), a1 = a.subspan(h);
+                auto const b0 = b.first(h), b1 = b.subspan(h);
+
+                std::vector<T> sum_a(a1.begin(), a1.end());
+                std::vector<T> sum_b(std::max(h, b1.size()));
+
+                for( std::size_t i{ 0 }; i < h; ++i )
+                {
+                    sum_a[i] += a0[i];
+                    sum_b[i] = b0[i];
+                }
+
+                for( std::size_t i{ 0 }; i < b1.size(); ++i )
+                {
+                    sum_b[i] += b1[i];
+                }
+
+                auto const z0 = multiply_karatsuba(a0, b0, threshold);
+                auto const z2 = multiply_karatsuba(a1, b1, threshold);
+                auto const z1 = multiply_karatsuba(std::span<T const>{ sum_a }, std::span<T const>{ sum_b }, threshold);
+
+                for( std::size_t i{ 0 }; i < z0.size(); ++i )
+                {
+                    result[i] += z0[i];
+                    result[i + h] -= z0[i];
+                }
+
+                for( std::size_t i{ 0 }; i < z2.size(); ++i )
+                {
+                    result[i + 2 * h] += z2[i];
+                    result[i + h] -= z2[i];
+                }
+
+                for( std::size_t i{ 0 }; i < z1.size() && i + h < result.size(); ++i )
+                {   // Coefficients of z1 past the product's length are zero.
+                    result[i + h] += z1[i];
+                }
+
+                return result;
+            }
+
+            template <s64 N>
+            constexpr auto three_prime_max_terms() noexcept -> std::size_t
+            {
+                constexpr double product{ 998244353.0 * 167772161.0 * 469762049.0 };
+                constexpr double square{ (N - 1.0) * (N - 1.0) };
+                constexpr double bound{ product / square * (1.0 - 1.0 / (1 << 20)) };
+
+                constexpr std::size_t max_size{ ntt_plan<three_prime_rns::moduli[0]>::max_size() };
+
+                return bound >= static_cast<double>(max_size) ? max_size : static_cast<std::size_t>(bound);
+            }
+
+            template <s64 P, typename Reduction, typename S>
+            auto cyclic_convolution(std::span<S const> const a, std::span<S const> const b, ntt_plan<P, Reduction> const &plan)
+                -> std::vector<int_mod<P, Reduction>>
+            {
+                using F = int_mod<P, Reduction>;
+
+                std::vector<F> fa(plan.size()), fb(plan.size());
+
+                if constexpr( std::is_same_v<S, F> )
+                {
+                    std::copy(a.begin(), a.end(), fa.begin());
+                    std::copy(b.begin(), b.end(), fb.begin());
+                }
+                else
+                {
+                    std::transform(a.begin(), a.end(), fa.begin(), [](S const x) { return F{ x.value() }; });
+                    std::transform(b.begin(), b.end(), fb.begin(), [](S const x) { return F{ x.value() }; });
+                }
+
+                plan.forward(std::span{ fa });
+                plan.forward(std::span{ fb });
+
+                for( std::size_t i{ 0 }; i < fa.size(); ++i )
+                {
+                    fa[i] *= fb[i];
+                }
+
+                plan.inverse(std::span{ fa });
+
+                return fa;
+            }
+
+            template <s64 N, typename Reduction>
+            auto multiply_ntt(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b)
+                -> std::vector<int_mod<N, Reduction>>
+            {
+                std::size_t const result_size{ a.size() + b.size() - 1 };
+                int const log_size{ static_cast<int>(std::bit_width(result_size - 1)) };
+
+                auto result = cyclic_convolution(a, b, cached_ntt_plan<N, Reduction>(log_size));
+                result.resize(result_size);
+
+                return result;
+            }
+
+            template <s64 N, typename Reduction>
+            auto multiply_three_primes(std::span<int_mod<N, Reduction> const> const a, std::span<int_mod<N, Reduction> const> const b,
+                                       bool const parallel) -> std::vector<int_mod<N, Reduction>>
+            {
+                constexpr auto P0 = three_prime_rns::moduli[0];
+                constexpr auto P1 = three_prime_rns::moduli[1];
+                constexpr auto P2 = three_prime_rns::moduli[2];
+
+                std::size_t const result_size{ a.size() + b.size() - 1 };
+                int const log_size{ static_cast<int>(std::bit_width(result_size - 1)) };
+
+                // Plans come from this thread's cache; they are only read while transforming, so workers can share them.
+                auto const &plan0 = cached_ntt_plan<P0, remainder_reduction>(log_size);
+                auto const &plan1 = cached_ntt_plan<P1, remainder_reduction>(log_size);
+                auto const &plan2 = cached_ntt_plan<P2, remainder_reduction>(log_size);
+
+                std::vector<int_mod<P0>> c0;
+                std::vector<int_mod<P1>> c1;
+                std::vector<int_mod<P2>> c2;
+
+                if( parallel )
+                {
+                    std::thread t1{ [&] { c1 = cyclic_convolution(a, b, plan1); } };
+                    std::thread t2{ [&] { c2 = cyclic_convolution(a, b, plan2); } };
+                    c0 = cyclic_convolution(a, b, plan0);
+                    t1.join();
+                    t2.join();
+                }
+                else
+                {
+                    c0 = cyclic_convolution(a, b, plan0);
+                    c1 = cyclic_convolution(a, b, plan1);
+                    c2 = cyclic_convolution(a, b, plan2);
+                }
+
+                std::vector<int_mod<N, Reduction>> result(result_size);
+
+                for( std::size_t i{ 0 }; i < result_size; ++i )
+                {
+                    result[i] = three_prime_rns{ three_prime_rns::tuple_type{ c0[i], c1[i], c2[i] } }.template reduce<N, Reduction>();
+                }
+
+                return result;
+            }
+
+            template <typename T>
+            subproduct_tree<T>::subproduct_tree(std::span<T const> const points)
+                : size_{ points.size() }, nodes_(4 * points.size())
+            {
+                build(points, 1, 0, size_);
+            }
+
+            template <typename T>
+            auto subproduct_tree<T>::build(std::span<T const> const points, std::size_t const node, std::size_t const first,
+                                           std::size_t const last) -> void
+            {
+                if( last - first == 1 )
+                {
+                    nodes_[node] = polynomial<T>{ -points[first], T{ 1 } };
+                    return;
+                }
+
+                std::size_t const middle{ first + (last - first) / 2 };
+
+                build(points, 2 * node, first, middle);
+                build(points, 2 * node + 1, middle, last);
+
+                nodes_[node] = nodes_[2 * node] * nodes_[2 * node + 1];
+            }
+
+            template <typename T>
+            auto subproduct_tree<T>::evaluate(polynomial<T> const &p, std::span<T const> const points) const -> std::vector<T>
+            {
+                std::vector<T> values(size_);
+                evaluate(p % root(), points, 1, 0, size_, values);
+
+                return values;
+            }
+
+            template <typename T>
+            auto subproduct_tree<T>::evaluate(polynomial<T> const &p, std::span<T const> const points, std::size_t const node,
+                                              std::size_t const first, std::size_t const last, std::vector<T> &values) const -> void
+            {
+                if( last - first <= leaf_size )
+                {
+                    for( std::size_t i{ first }; i < last; ++i )
+                    {
+                        values[i] = p(points[i]);
+                    }
+
+                    return;
+                }
+
+                std::size_t const middle{ first + (last - first) / 2 };
+
+                evaluate(p % nodes_[2 * node], points, 2 * node, first, middle, values);
+                evaluate(p % nodes_[2 * node + 1], points, 2 * node + 1, middle, last, values);
+            }
+
+            template <typename T>
+            auto subproduct_tree<T>::combine(std::span<T const> const weights) const -> polynomial<T>
+            {
+                return combine(weights, 1, 0, size_);
+            }
+
+            template <typename T>
+            auto subproduct_tree<T>::combine(std::span<T const> const weights, std::size_t const node, std::size_t const first,
+                                             std::size_t const last) const -> polynomial<T>
+            {
+                if( last - first == 1 )
+                {
+                    return polynomial<T>{ weights[first] };
+                }
+
+                std::size_t const middle{ first + (last - first) / 2 };
+
+                return combine(weights, 2 * node, first, middle) * nodes_[2 * node + 1]
+                     + combine(weights, 2 * node + 1, middle, last) * nodes_[2 * node];
+            }
+
+        } // namespace impl_details
+
+        template <s64 N, typename Reduction>
+        polynomial<int_mod<N, Reduction>>::polynomial(std::vector<value_type> coefficients)
+            : coefficients_{ std::move(coefficients) }
+        {
+            normalize();
+        }
+
+        template <s64 N, typename Reduction>
+        polynomial<int_mod<N, Reduction>>::polynomial(std::initializer_list<value_type> const coefficients)
+            : coefficients_(coefficients)
+        {
+            normalize();
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::normalize() -> void
+        {
+            while( !coefficients_.empty() && coefficients_.back() == 0 )
+            {
+                coefficients_.pop_back();
+            }
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator()(value_type const x) const noexcept -> value_type
+        {
+            value_type result{ 0 };
+
+            for( auto it = coefficients_.rbegin(); it != coefficients_.rend(); ++it )
+            {
+                result = result * x + *it;
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::evaluate(std::span<value_type const> const points) const -> std::vector<value_type>
+        {
+            if( points.size() <= subproduct_threshold || size() <= subproduct_threshold )
+            {
+                std::vector<value_type> values(points.size());
+
+                for( std::size_t i{ 0 }; i < points.size(); ++i )
+                {
+                    values[i] = (*this)(points[i]);
+                }
+
+                return values;
+            }
+
+            return impl_details::subproduct_tree<value_type>{ points }.evaluate(*this, points);
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::interpolate(std::span<value_type const> const points, std::span<value_type const> const values)
+            -> polynomial
+        {
+            if( points.size() != values.size() )
+            {
+                throw std::invalid_argument("interpolate was given " + std::to_string(points.size()) + " points but "
+                    + std::to_string(values.size()) + " values.\n");
+            }
+
+            if( points.empty() )
+            {
+                return polynomial{ };
+            }
+
+            // f = sum_i y_i / M'(x_i) * M(x) / (x - x_i), with M the product of all x - x_i.
+            impl_details::subproduct_tree<value_type> const tree{ points };
+            std::vector<value_type> weights{ tree.evaluate(tree.root().derivative(), points) };
+
+            if( batch_inverse(std::span{ weights }) != weights.size() )
+            {
+                throw std::invalid_argument{ "interpolate requires the differences of the points to be invertible.\n" };
+            }
+
+            for( std::size_t i{ 0 }; i < weights.size(); ++i )
+            {
+                weights[i] *= values[i];
+            }
+
+            return tree.combine(weights);
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::derivative() const -> polynomial
+        {
+            std::vector<value_type> result(coefficients_.empty() ? 0 : coefficients_.size() - 1);
+
+            for( std::size_t i{ 0 }; i < result.size(); ++i )
+            {
+                result[i] = coefficients_[i + 1] * static_cast<s64>(i + 1);
+            }
+
+            return polynomial{ std::move(result) };
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::truncate(std::size_t const n) const -> polynomial
+        {
+            return polynomial{ std::vector<value_type>(coefficients_.begin(), coefficients_.begin() + std::min(n, size())) };
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::reverse(std::size_t const n) const -> polynomial
+        {
+            std::vector<value_type> result(coefficients_);
+            result.resize(std::max(n, size()));
+            std::reverse(result.begin(), result.end());
+
+            return polynomial{ std::move(result) };
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::inverse(std::size_t const n) const -> polynomial
+        {
+            auto const first = (*this)[0].try_inverse();
+
+            if( !first )
+            {
+                throw std::invalid_argument("Power series inverse requires an invertible constant term, but gcd("
+                    + std::to_string((*this)[0].value()) + ", " + std::to_string(N) + ") is not 1.\n");
+            }
+
+            // g <- g (2 - p g) mod x^2k doubles the number of correct coefficients each step.
+            polynomial result{ *first };
+
+            for( std::size_t k{ 1 }; k < n; )
+            {
+                k = std::min(2 * k, n);
+
+                polynomial correction{ -(truncate(k) * result).truncate(k) };
+                correction.coefficients_.resize(std::max<std::size_t>(correction.size(), 1));
+                correction.coefficients_[0] += 2;
+                correction.normalize();
+
+                result = (result * correction).truncate(k);
+            }
+
+            return result.truncate(n);
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::divide(polynomial const &divisor) const -> std::pair<polynomial, polynomial>
+        {
+            if( divisor.is_zero() )
+            {
+                throw std::invalid_argument{ "Polynomial division by zero." };
+            }
+
+            if( size() < divisor.size() )
+            {
+                return { polynomial{ }, *this };
+            }
+
+            std::size_t const quotient_size{ size() - divisor.size() + 1 };
+
+            if( quotient_size < newton_threshold || divisor.size() < newton_threshold )
+            {
+                value_type const lead_inverse{ divisor.coefficients_.back().inverse() };
+                std::vector<value_type> remainder(coefficients_);
+                std::vector<value_type> quotient(quotient_size);
+
+                for( std::size_t i{ quotient_size }; i-- > 0; )
+                {
+                    value_type const q{ remainder[i + divisor.size() - 1] * lead_inverse };
+                    quotient[i] = q;
+
+                    for( std::size_t j{ 0 }; j < divisor.size(); ++j )
+                    {
+                        remainder[i + j] -= q * divisor.coefficients_[j];
+                    }
+                }
+
+                remainder.resize(divisor.size() - 1);
+
+                return { polynomial{ std::move(quotient) }, polynomial{ std::move(remainder) } };
+            }
+
+            // rev(q) = rev(a) / rev(b) mod x^(deg a - deg b + 1).
+            polynomial const reversed_quotient{ (reverse(size()).truncate(quotient_size)
+                                               * divisor.reverse(divisor.size()).inverse(quotient_size)).truncate(quotient_size) };
+            polynomial quotient{ reversed_quotient.reverse(quotient_size) };
+            polynomial remainder{ (*this - quotient * divisor).truncate(divisor.size() - 1) };
+
+            return { std::move(quotient), std::move(remainder) };
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::multiply(std::span<value_type const> const a, std::span<value_type const> const b)
+            -> std::vector<value_type>
+        {
+            if( a.empty() || b.empty() )
+            {
+                return { };
+            }
+
+            std::size_t const shorter{ std::min(a.size(), b.size()) };
+
+            if( shorter <= karatsuba_threshold )
+            {
+                return impl_details::multiply_schoolbook(a, b);
+            }
+
+            if constexpr( impl_details::ntt_friendly<N>() )
+            {
+                if( shorter >= ntt_threshold && a.size() + b.size() - 1 <= ntt_plan<N, Reduction>::max_size() )
+                {
+                    return impl_details::multiply_ntt(a, b);
+                }
+            }
+            else if constexpr( impl_details::three_prime_max_terms<N>() >= three_prime_threshold )
+            {
+                if( shorter >= three_prime_threshold && shorter <= impl_details::three_prime_max_terms<N>()
+                    && a.size() + b.size() - 1 <= ntt_plan<impl_details::three_prime_rns::moduli[0]>::max_size() )
+                {
+                    return impl_details::multiply_three_primes(a, b, std::thread::hardware_concurrency() >= 3);
+                }
+            }
+
+            return impl_details::multiply_karatsuba(a, b, karatsuba_threshold);
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator-() const -> polynomial
+        {
+            polynomial result{ *this };
+
+            for( auto &c : result.coefficients_ )
+            {
+                c = -c;
+            }
+
+            return result;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator+=(polynomial const &rhs) -> polynomial &
+        {
+            coefficients_.resize(std::max(size(), rhs.size()));
+
+            for( std::size_t i{ 0 }; i < rhs.size(); ++i )
+            {
+                coefficients_[i] += rhs.coefficients_[i];
+            }
+
+            normalize();
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator-=(polynomial const &rhs) -> polynomial &
+        {
+            coefficients_.resize(std::max(size(), rhs.size()));
+
+            for( std::size_t i{ 0 }; i < rhs.size(); ++i )
+            {
+                coefficients_[i] -= rhs.coefficients_[i];
+            }
+
+            normalize();
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator*=(polynomial const &rhs) -> polynomial &
+        {
+            coefficients_ = multiply(coefficients_, rhs.coefficients_);
+            normalize();
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator*=(value_type const rhs) -> polynomial &
+        {
+            fixed_multiplier<N, Reduction> const factor{ rhs };
+
+            for( auto &c : coefficients_ )
+            {
+                c *= factor;
+            }
+
+            normalize();
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator/=(polynomial const &rhs) -> polynomial &
+        {
+            *this = divide(rhs).first;
+
+            return *this;
+        }
+
+        template <s64 N, typename Reduction>
+        auto polynomial<int_mod<N, Reduction>>::operator%=(polynomial const &rhs) -> polynomial &
+        {
+            *this = divide(rhs).second;
+
+            return *this;
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
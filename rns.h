@@ -0,0 +1,482 @@
+#pragma once
+#ifndef MATH_NERD_RNS_H
+#define MATH_NERD_RNS_H
+
+/** \file rns.h
+    \brief Residue number system over pairwise coprime moduli, for arithmetic on integers far beyond 64 bits.
+ */
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "int_mod.h"
+
+/** \namespace math_nerd
+    \brief Namespace for all of my projects.
+ */
+namespace math_nerd
+{
+    /** \namespace math_nerd::int_mod
+        \brief Namespace for int_mod<N> implementation.
+     */
+    namespace int_mod
+    {
+        namespace impl_details
+        {
+            /** \fn constexpr auto pairwise_coprime(std::array<s64, K> const &moduli) noexcept -> bool
+                \brief Returns true if no two of the moduli share a factor.
+             */
+            template <std::size_t K>
+            constexpr auto pairwise_coprime(std::array<s64, K> const &moduli) noexcept -> bool;
+
+            /** \struct garner_constants<K>
+                \brief The constants of Garner's algorithm for K moduli \f$N_0, \ldots, N_{K-1}\f$.
+             */
+            template <std::size_t K>
+            struct garner_constants
+            {
+                /** \property std::array<s64, K> inverse
+                    \brief inverse[i] is \f$\left(N_0 \cdots N_{i-1}\right)^{-1} \bmod N_i\f$; inverse[0] is 1.
+                 */
+                std::array<s64, K> inverse{ };
+
+                /** \property std::array<std::array<s64, K>, K> prefix
+                    \brief prefix[i][j] is \f$N_0 \cdots N_{j-1} \bmod N_i\f$ for j < i.
+                 */
+                std::array<std::array<s64, K>, K> prefix{ };
+            };
+
+            /** \fn constexpr auto make_garner_constants(std::array<s64, K> const &moduli) noexcept -> garner_constants<K>
+                \brief Computes the Garner constants of pairwise coprime moduli.
+             */
+            template <std::size_t K>
+            constexpr auto make_garner_constants(std::array<s64, K> const &moduli) noexcept -> garner_constants<K>;
+
+            /** \fn constexpr auto prefix_products_modulo(std::array<s64, K> const &moduli) noexcept -> std::array<s64, K>
+                \brief Returns \f$N_0 \cdots N_{j-1} \bmod M\f$ for j = 0, ..., K - 1.
+             */
+            template <s64 M, std::size_t K>
+            constexpr auto prefix_products_modulo(std::array<s64, K> const &moduli) noexcept -> std::array<s64, K>;
+
+        } // namespace impl_details
+
+        /** \class rns<Ns...>
+            \brief An integer in \f$[0, M)\f$, \f$M = N_0 \cdots N_{K-1}\f$, stored as its residues modulo each \f$N_i\f$.
+            \details Addition, subtraction and multiplication are exact modulo M and act on each residue on its own,
+                     so the K operations have no carries between them and the CPU overlaps them freely. Converting
+                     back goes through Garner's mixed-radix digits, whose constants are computed at compile time.
+                     With five moduli near \f$2^{62}\f$, M has 310 bits.
+         */
+        template <s64... Ns>
+        class rns
+        {
+            static_assert(sizeof...(Ns) >= 1, "rns<N...> needs at least one modulus.");
+
+        public:
+            /** \typedef tuple_type
+                \brief The residues, one int_mod<N_i> per modulus.
+             */
+            using tuple_type = std::tuple<int_mod<Ns>...>;
+
+            /** \property static constexpr std::size_t size
+                \brief Number of moduli.
+             */
+            static constexpr std::size_t size{ sizeof...(Ns) };
+
+            /** \property static constexpr std::array<s64, size> moduli
+                \brief The moduli, in order.
+             */
+            static constexpr std::array<s64, size> moduli{ Ns... };
+
+            static_assert(impl_details::pairwise_coprime(moduli), "Moduli of rns<N...> must be pairwise coprime.");
+
+        private:
+            /** \property tuple_type residues_
+                \brief The residues. Default initializes to 0.
+             */
+            tuple_type residues_{ };
+
+            /** \property static constexpr impl_details::garner_constants<size> garner_
+                \brief Constants for mixed_radix().
+             */
+            static constexpr impl_details::garner_constants<size> garner_{ impl_details::make_garner_constants(moduli) };
+
+            /** \property static constexpr std::array<s64, size> prefix_modulo_<M>
+                \brief Constants for reduce<M>().
+             */
+            template <s64 M>
+            static constexpr std::array<s64, size> prefix_modulo_{ impl_details::prefix_products_modulo<M>(moduli) };
+
+            /** \fn constexpr auto for_each_index(F &&f) -> void
+                \brief Calls f(std::integral_constant<std::size_t, I>{ }) for I = 0, ..., Count - 1.
+             */
+            template <std::size_t Count = size, typename F>
+            static constexpr auto for_each_index(F &&f) -> void;
+
+        public:
+            constexpr rns() = default;
+
+            constexpr rns(s64 const num) noexcept
+                : residues_{ int_mod<Ns>{ num }... }
+            {
+            }
+
+            constexpr explicit rns(tuple_type const &residues) noexcept
+                : residues_{ residues }
+            {
+            }
+
+            /** \fn constexpr auto residues() const noexcept -> tuple_type const &
+                \brief Returns the residues.
+             */
+            constexpr auto residues() const noexcept -> tuple_type const &
+            {
+                return residues_;
+            }
+
+            /** \fn constexpr auto get() const noexcept -> std::tuple_element_t<I, tuple_type>
+                \brief Returns the residue modulo moduli[I].
+             */
+            template <std::size_t I>
+            constexpr auto get() const noexcept -> std::tuple_element_t<I, tuple_type>
+            {
+                return std::get<I>(residues_);
+            }
+
+            /** \fn constexpr auto mixed_radix() const noexcept -> std::array<s64, size>
+                \brief Returns the digits \f$v_i \in [0, N_i)\f$ with \f$x = v_0 + v_1 N_0 + v_2 N_0 N_1 + \cdots\f$.
+                \details Garner's algorithm: \f$v_i = \left(x_i - \sum_{j<i} v_j N_0 \cdots N_{j-1}\right) \left(N_0 \cdots N_{i-1}\right)^{-1} \bmod N_i\f$.
+                         Every prefix product is a compile-time constant, so the \f$O(K^2)\f$ multiplications modulo the
+                         \f$N_i\f$ are independent of one another within each digit, and none is wider than 128 bits.
+             */
+            constexpr auto mixed_radix() const noexcept -> std::array<s64, size>;
+
+            /** \fn constexpr auto reduce() const noexcept -> int_mod<M, Reduction>
+                \brief Returns the integer modulo M, which need not be related to the moduli.
+                \details Sums the mixed-radix digits times \f$N_0 \cdots N_{j-1} \bmod M\f$, constants computed at compile time.
+             */
+            template <s64 M, typename Reduction = remainder_reduction>
+            constexpr auto reduce() const noexcept -> int_mod<M, Reduction>;
+
+            /** \fn auto to_string() const -> std::string
+                \brief Returns the integer in \f$[0, M)\f$ in decimal.
+             */
+            auto to_string() const -> std::string;
+
+            /** \name Unary operators */
+            /** \fn constexpr auto operator-() const noexcept -> rns<Ns...>
+                \brief Returns the additive inverse modulo M.
+             */
+            constexpr auto operator-() const noexcept -> rns<Ns...>;
+
+            /** \name Assignment operators */
+            /** \fn constexpr auto operator+=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+                \brief Adds rhs residue by residue.
+             */
+            constexpr auto operator+=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &;
+
+            /** \fn constexpr auto operator-=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+                \brief Subtracts rhs residue by residue.
+             */
+            constexpr auto operator-=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &;
+
+            /** \fn constexpr auto operator*=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+                \brief Multiplies by rhs residue by residue.
+             */
+            constexpr auto operator*=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &;
+
+            /** \name Comparison operators */
+            /** \fn constexpr auto operator==(rns<Ns...> const &rhs) const noexcept -> bool
+                \brief Returns true if every residue is equal, that is, if the integers are equal.
+             */
+            constexpr auto operator==(rns<Ns...> const &rhs) const noexcept -> bool
+            {
+                return residues_ == rhs.residues_;
+            }
+        };
+
+        /** \fn constexpr auto operator+(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+            \brief Returns lhs + rhs modulo M.
+         */
+        template <s64... Ns>
+        constexpr auto operator+(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+        {
+            return lhs += rhs;
+        }
+
+        /** \fn constexpr auto operator-(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+            \brief Returns lhs - rhs modulo M.
+         */
+        template <s64... Ns>
+        constexpr auto operator-(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+        {
+            return lhs -= rhs;
+        }
+
+        /** \fn constexpr auto operator*(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+            \brief Returns lhs * rhs modulo M.
+         */
+        template <s64... Ns>
+        constexpr auto operator*(rns<Ns...> lhs, rns<Ns...> const &rhs) noexcept -> rns<Ns...>
+        {
+            return lhs *= rhs;
+        }
+
+        /** \fn auto operator<<(std::ostream &os, rns<Ns...> const &rhs) -> std::ostream &
+            \brief Outputs the integer in decimal. Returns the ostream object for further output.
+         */
+        template <s64... Ns>
+        auto operator<<(std::ostream &os, rns<Ns...> const &rhs) -> std::ostream &
+        {
+            os << rhs.to_string();
+            return os;
+        }
+
+        // Implementation function definitions.
+        namespace impl_details
+        {
+            template <std::size_t K>
+            constexpr auto pairwise_coprime(std::array<s64, K> const &moduli) noexcept -> bool
+            {
+                for( std::size_t i{ 0 }; i < K; ++i )
+                {
+                    for( std::size_t j{ 0 }; j < i; ++j )
+                    {
+                        if( gcd(moduli[i], moduli[j]) != 1 )
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+            template <std::size_t K>
+            constexpr auto make_garner_constants(std::array<s64, K> const &moduli) noexcept -> garner_constants<K>
+            {
+                garner_constants<K> result;
+
+                for( std::size_t i{ 0 }; i < K; ++i )
+                {
+                    auto const n = static_cast<u64>(moduli[i]);
+                    u64 prefix{ 1 % n };
+
+                    for( std::size_t j{ 0 }; j < i; ++j )
+                    {
+                        result.prefix[i][j] = static_cast<s64>(prefix);
+                        prefix = mul_mod(prefix, static_cast<u64>(moduli[j]) % n, n);
+                    }
+
+                    result.inverse[i] = gcd_and_inverse(static_cast<s64>(prefix), moduli[i]).second;
+                }
+
+                return result;
+            }
+
+            template <s64 M, std::size_t K>
+            constexpr auto prefix_products_modulo(std::array<s64, K> const &moduli) noexcept -> std::array<s64, K>
+            {
+                std::array<s64, K> result{ };
+                u64 prefix{ 1 % static_cast<u64>(M) };
+
+                for( std::size_t j{ 0 }; j < K; ++j )
+                {
+                    result[j] = static_cast<s64>(prefix);
+                    prefix = mul_mod(prefix, static_cast<u64>(moduli[j]) % static_cast<u64>(M), static_cast<u64>(M));
+                }
+
+                return result;
+            }
+
+        } // namespace impl_details
+
+        template <s64... Ns>
+        template <std::size_t Count, typename F>
+        constexpr auto rns<Ns...>::for_each_index(F &&f) -> void
+        {
+            [&]<std::size_t... I>(std::index_sequence<I...>)
+            {
+                (f(std::integral_constant<std::size_t, I>{ }), ...);
+            }(std::make_index_sequence<Count>{ });
+        }
+
+        template <s64... Ns>
+        constexpr auto rns<Ns...>::mixed_radix() const noexcept -> std::array<s64, size>
+        {
+            std::array<s64, size> digits{ };
+
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t i{ decltype(index)::value };
+                using F = std::tuple_element_t<i, tuple_type>;
+
+                F known{ 0 };
+
+                for_each_index<i>([&](auto const inner)
+                {
+                    constexpr std::size_t j{ decltype(inner)::value };
+                    constexpr F prefix{ garner_.prefix[i][j] };
+
+                    known += F{ digits[j] } * prefix;
+                });
+
+                constexpr F inverse{ garner_.inverse[i] };
+                digits[i] = ((std::get<i>(residues_) - known) * inverse).value();
+            });
+
+            return digits;
+        }
+
+        template <s64... Ns>
+        template <s64 M, typename Reduction>
+        constexpr auto rns<Ns...>::reduce() const noexcept -> int_mod<M, Reduction>
+        {
+            using F = int_mod<M, Reduction>;
+            auto const digits = mixed_radix();
+            F result{ 0 };
+
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t j{ decltype(index)::value };
+                constexpr F factor{ prefix_modulo_<M>[j] };
+
+                result += F{ digits[j] } * factor;
+            });
+
+            return result;
+        }
+
+        template <s64... Ns>
+        auto rns<Ns...>::to_string() const -> std::string
+        {
+            auto const digits = mixed_radix();
+
+            // Horner's rule over 32-bit limbs, least significant first.
+            std::vector<u32> limbs{ 0 };
+
+            for( std::size_t j{ size }; j-- > 0; )
+            {   // limbs = limbs * N_j + v_j, taking N_j and v_j in 32-bit halves.
+                auto const n = static_cast<u64>(moduli[j]);
+                auto const v = static_cast<u64>(digits[j]);
+                std::vector<u32> next(limbs.size() + 3, 0);
+
+                auto const add_at = [&next](std::size_t k, u64 carry)
+                {
+                    for( ; carry != 0; ++k )
+                    {
+                        u64 const t{ next[k] + (carry & 0xFFFFFFFFu) };
+                        next[k] = static_cast<u32>(t);
+                        carry = (carry >> 32) + (t >> 32);
+                    }
+                };
+
+                for( std::size_t k{ 0 }; k < limbs.size(); ++k )
+                {
+                    add_at(k, static_cast<u64>(limbs[k]) * (n & 0xFFFFFFFFu));
+                    add_at(k + 1, static_cast<u64>(limbs[k]) * (n >> 32));
+                }
+
+                add_at(0, v);
+
+                while( next.size() > 1 && next.back() == 0 )
+                {
+                    next.pop_back();
+                }
+
+                limbs = std::move(next);
+            }
+
+            // Peel off nine decimal digits at a time.
+            std::string result;
+
+            do
+            {
+                u64 remainder{ 0 };
+
+                for( std::size_t k{ limbs.size() }; k-- > 0; )
+                {
+                    u64 const t{ (remainder << 32) | limbs[k] };
+                    limbs[k] = static_cast<u32>(t / 1000000000);
+                    remainder = t % 1000000000;
+                }
+
+                while( limbs.size() > 1 && limbs.back() == 0 )
+                {
+                    limbs.pop_back();
+                }
+
+                bool const last{ limbs.size() == 1 && limbs[0] == 0 };
+
+                for( int d{ 0 }; d < 9 && (!last || remainder != 0 || d == 0); ++d )
+                {
+                    result.push_back(static_cast<char>('0' + remainder % 10));
+                    remainder /= 10;
+                }
+            } while( limbs.size() > 1 || limbs[0] != 0 );
+
+            std::reverse(result.begin(), result.end());
+
+            return result;
+        }
+
+        template <s64... Ns>
+        constexpr auto rns<Ns...>::operator-() const noexcept -> rns<Ns...>
+        {
+            rns<Ns...> result{ *this };
+
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t i{ decltype(index)::value };
+                std::get<i>(result.residues_) = -std::get<i>(result.residues_);
+            });
+
+            return result;
+        }
+
+        template <s64... Ns>
+        constexpr auto rns<Ns...>::operator+=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+        {
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t i{ decltype(index)::value };
+                std::get<i>(residues_) += std::get<i>(rhs.residues_);
+            });
+
+            return *this;
+        }
+
+        template <s64... Ns>
+        constexpr auto rns<Ns...>::operator-=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+        {
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t i{ decltype(index)::value };
+                std::get<i>(residues_) -= std::get<i>(rhs.residues_);
+            });
+
+            return *this;
+        }
+
+        template <s64... Ns>
+        constexpr auto rns<Ns...>::operator*=(rns<Ns...> const &rhs) noexcept -> rns<Ns...> &
+        {
+            for_each_index([&](auto const index)
+            {
+                constexpr std::size_t i{ decltype(index)::value };
+                std::get<i>(residues_) *= std::get<i>(rhs.residues_);
+            });
+
+            return *this;
+        }
+
+    } // namespace int_mod
+
+} // namespace math_nerd
+
+#endif
@@ -1,6 +1,18 @@
 #include <sstream>
+#include <tuple>
 
+#include <math_nerd/discrete_log.h>
+#include <math_nerd/dynamic_int_mod.h>
+#include <math_nerd/exponentiation.h>
 #include <math_nerd/int_mod.h>
+#include <math_nerd/int_mod_accumulator.h>
+#include <math_nerd/int_mod_vector.h>
+#include <math_nerd/matrix.h>
+#include <math_nerd/modulus_traits.h>
+#include <math_nerd/montgomery_int_mod.h>
+#include <math_nerd/ntt.h>
+#include <math_nerd/polynomial.h>
+#include <math_nerd/rns.h>
 
 #define CATCH_DEFINE_MAIN
 #include "catch.hpp"
@@ -115,6 +127,55 @@ TEST_CASE("Testing inverse_of<N>()")
         REQUIRE(im::impl_details::inverse_of<1000000000>(1337) == 325355273);
     }
 
+    SECTION("gcd_and_inverse() Computes Both in One Pass")
+    {
+        REQUIRE(im::impl_details::gcd_and_inverse(12, 13) == std::pair<im::s64, im::s64>{ 1, 12 });
+        REQUIRE(im::impl_details::gcd_and_inverse(1337 % 69, 69) == std::pair<im::s64, im::s64>{ 1, 8 });
+        REQUIRE(im::impl_details::gcd_and_inverse(210, 308).first == 14);
+        REQUIRE(im::impl_details::gcd_and_inverse(0, 12).first == 12);
+        REQUIRE(im::impl_details::gcd_and_inverse(1, 2).second == 1);
+    }
+
+    SECTION("Prime Moduli Skip the gcd Check")
+    {
+        static_assert(im::impl_details::prime_modulus<2>);
+        static_assert(im::impl_details::prime_modulus<97>);
+        static_assert(im::impl_details::prime_modulus<2305843009213693951>);
+        static_assert(!im::impl_details::prime_modulus<1>);
+        static_assert(!im::impl_details::prime_modulus<561>);
+        static_assert(!im::impl_details::prime_modulus<4294967291 * 2147483647>);
+
+        static_assert(im::impl_details::prime_inverse_of<97>(3) == 65);
+
+        auto const check = []<im::s64 N>(im::int_mod<N>)
+        {   // Covers the Fermat, 32-bit and 64-bit paths.
+            for( im::s64 const n : { im::s64{ 1 }, im::s64{ 2 }, N / 3, N / 2 + 1, N - 2, N - 1 } )
+            {
+                if( n < 1 || n >= N )
+                {
+                    continue;
+                }
+
+                im::s64 const inv{ im::impl_details::prime_inverse_of<N>(n) };
+
+                REQUIRE(inv == im::impl_details::gcd_and_inverse(n, N).second);
+                REQUIRE(im::impl_details::mul_mod<N>(n, inv) == 1);
+            }
+
+            REQUIRE(!im::impl_details::try_inverse_of<N>(0));
+            REQUIRE(!im::impl_details::try_inverse_of<N>(N));
+        };
+
+        check(im::int_mod<2>{ });
+        check(im::int_mod<3>{ });
+        check(im::int_mod<251>{ });
+        check(im::int_mod<257>{ });
+        check(im::int_mod<998244353>{ });
+        check(im::int_mod<4294967291>{ });
+        check(im::int_mod<2305843009213693951>{ });
+        check(im::int_mod<9223372036854775783>{ });
+    }
+
     SECTION("Inverses Do Not Exist For Numbers With Factors In Common with the Modulus")
     {
         try
@@ -737,3 +798,1581 @@ TEST_CASE("Testing I/O Operators")
         REQUIRE(test_subject3 == 81);
     }
 }
+
+TEST_CASE("Testing montgomery_int_mod<N>")
+{
+    SECTION("Round Trip Through Montgomery Form")
+    {
+        REQUIRE(im::montgomery_int_mod<13>(12).value() == 12);
+        REQUIRE(im::montgomery_int_mod<15>(-1).value() == 14);
+        REQUIRE(im::montgomery_int_mod<1337>(420).value() == 420);
+        REQUIRE(im::montgomery_int_mod<998244353>(-1).value() == 998244352);
+        REQUIRE(im::montgomery_int_mod<999999937>(im::int_mod<999999937>(123456789)) == 123456789);
+    }
+
+    SECTION("Arithmetic Agrees With int_mod<N>")
+    {
+        REQUIRE(im::montgomery_int_mod<13>(12) * im::montgomery_int_mod<13>(20) == 6);
+        REQUIRE(im::montgomery_int_mod<15>(-1) * (-3) == 3);
+        REQUIRE(im::montgomery_int_mod<1337>(420) * 69 == 903);
+        REQUIRE(im::montgomery_int_mod<13>(12) + 20 == 6);
+        REQUIRE(3 - im::montgomery_int_mod<13>(5) == 11);
+        REQUIRE(-im::montgomery_int_mod<13>(0) == 0);
+        REQUIRE(im::montgomery_int_mod<1337>(420) / im::montgomery_int_mod<1337>(69) == 413);
+        REQUIRE(im::montgomery_int_mod<999999937>(999999936) * 999999936 == (im::int_mod<999999937>(999999936) * 999999936).value());
+    }
+
+    SECTION("Powers")
+    {
+        REQUIRE(im::montgomery_int_mod<5>(3).pow(8) == 1);
+        REQUIRE(im::montgomery_int_mod<17>(7).pow(81) == 7);
+        REQUIRE(im::montgomery_int_mod<1337>(420).pow(69) == 567);
+        REQUIRE(im::montgomery_int_mod<998244353>(3).pow(998244352) == 1);
+    }
+}
+
+TEST_CASE("Testing Moduli Beyond 32 Bits")
+{
+    constexpr im::s64 mersenne61{ 2305843009213693951 }; // 2^61 - 1
+    constexpr im::s64 max_modulus{ 9223372036854775807 }; // 2^63 - 1
+
+    SECTION("mul_mod<N> Agrees With Narrow Path")
+    {
+        REQUIRE(im::impl_details::mul_mod<1337>(420, 69) == 903);
+        REQUIRE(im::impl_details::mul_mod<mersenne61>(mersenne61 - 1, mersenne61 - 1) == 1);
+        REQUIRE(im::impl_details::mul_mod<max_modulus>(max_modulus - 1, 2) == max_modulus - 2);
+        REQUIRE(im::impl_details::mul_mod<mersenne61>(1ll << 40, 1ll << 40) == (1ll << 19));
+    }
+
+    SECTION("Arithmetic Operators Do Not Overflow")
+    {
+        REQUIRE(im::int_mod<max_modulus>(max_modulus - 1) + im::int_mod<max_modulus>(max_modulus - 1) == max_modulus - 2);
+        REQUIRE(im::int_mod<max_modulus>(max_modulus - 1) + (max_modulus - 1) == max_modulus - 2);
+        REQUIRE(im::int_mod<max_modulus>(1) - im::int_mod<max_modulus>(max_modulus - 1) == 2);
+        REQUIRE(im::int_mod<mersenne61>(-1) * im::int_mod<mersenne61>(-1) == 1);
+        REQUIRE(im::int_mod<mersenne61>(1ll << 60) * 2 == 1);
+    }
+
+    SECTION("Powers and Inverses")
+    {
+        REQUIRE(im::impl_details::ipow<mersenne61>(2, 61) == 1);
+        REQUIRE(im::impl_details::ipow<mersenne61>(3, mersenne61 - 1) == 1);
+        REQUIRE(im::impl_details::inverse_of<mersenne61>(2) == (1ll << 60));
+        REQUIRE(im::int_mod<mersenne61>(123456789) / im::int_mod<mersenne61>(123456789) == 1);
+        REQUIRE(im::int_mod<max_modulus>(2).inverse() == max_modulus / 2 + 1);
+
+        try
+        {
+            im::impl_details::inverse_of<max_modulus>(7);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "7 is not invertible modulo 9223372036854775807 because gcd(7, 9223372036854775807) = 7, which is not 1.\n");
+        }
+    }
+
+    SECTION("Montgomery Form With R = 2^64")
+    {
+        REQUIRE(im::montgomery_int_mod<mersenne61>(-1).value() == mersenne61 - 1);
+        REQUIRE(im::montgomery_int_mod<mersenne61>(-1) * im::montgomery_int_mod<mersenne61>(-1) == 1);
+        REQUIRE(im::montgomery_int_mod<mersenne61>(3).pow(mersenne61 - 1) == 1);
+        REQUIRE(im::montgomery_int_mod<max_modulus>(max_modulus - 1) * 2 == max_modulus - 2);
+    }
+}
+
+TEST_CASE("Testing barrett_reduction")
+{
+    constexpr im::s64 mersenne61{ 2305843009213693951 }; // 2^61 - 1
+
+    using barrett13 = im::int_mod<13, im::barrett_reduction>;
+    using barrett_big = im::int_mod<998244353, im::barrett_reduction>;
+    using barrett61 = im::int_mod<mersenne61, im::barrett_reduction>;
+
+    SECTION("standard_modulo<N, barrett_reduction> Agrees With standard_modulo<N>")
+    {
+        REQUIRE(im::impl_details::standard_modulo<13, im::barrett_reduction>(-1) == 12);
+        REQUIRE(im::impl_details::standard_modulo<13, im::barrett_reduction>(-13) == 0);
+        REQUIRE(im::impl_details::standard_modulo<1024, im::barrett_reduction>(1023) == 1023);
+        REQUIRE(im::impl_details::standard_modulo<1024, im::barrett_reduction>(1024) == 0);
+        REQUIRE(im::impl_details::standard_modulo<998244353, im::barrett_reduction>(INT64_MIN) == im::impl_details::standard_modulo<998244353>(INT64_MIN));
+        REQUIRE(im::impl_details::standard_modulo<998244353, im::barrett_reduction>(INT64_MAX) == im::impl_details::standard_modulo<998244353>(INT64_MAX));
+    }
+
+    SECTION("Arithmetic Agrees With remainder_reduction")
+    {
+        REQUIRE(barrett13(12) * barrett13(20) == 6);
+        REQUIRE(barrett13(-1) * (-3) == 3);
+        REQUIRE(barrett13(12) / barrett13(20) == 11);
+        REQUIRE(barrett_big(-1) * barrett_big(-1) == 1);
+        REQUIRE(barrett61(-1) * barrett61(-1) == 1);
+        REQUIRE(barrett61(1ll << 60) * 2 == 1);
+
+        im::int_mod<998244353> x{ 3 };
+        barrett_big y{ 3 };
+
+        for( auto i{ 0 }; i < 1000; ++i )
+        {
+            x *= x + i;
+            y *= y + i;
+            REQUIRE(x.value() == y.value());
+        }
+    }
+}
+
+TEST_CASE("Testing dynamic_int_mod")
+{
+    im::modulus_context const mod13{ 13 };
+    im::modulus_context const mod1337{ 1337 };
+    im::modulus_context const mersenne61{ 2305843009213693951 };
+
+    SECTION("modulus_context Precomputations")
+    {
+        REQUIRE(mod13.phi() == 12);
+        REQUIRE(mod13.is_prime());
+        REQUIRE(mod1337.phi() == 1140);
+        REQUIRE(mod1337.factors() == std::vector<std::pair<im::s64, int>>{ { 7, 1 }, { 191, 1 } });
+        REQUIRE(mersenne61.is_prime());
+        REQUIRE(im::modulus_context{ 1000000000 }.phi() == 400000000);
+        REQUIRE(im::modulus_context{ 9223372036854775807 }.factors() == std::vector<std::pair<im::s64, int>>{ { 7, 2 }, { 73, 1 }, { 127, 1 }, { 337, 1 }, { 92737, 1 }, { 649657, 1 } });
+        REQUIRE(im::modulus_context{ 1000000007ll * 998244353ll }.factors() == std::vector<std::pair<im::s64, int>>{ { 998244353, 1 }, { 1000000007, 1 } });
+
+        try
+        {
+            im::modulus_context{ 1 };
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Modulus 1 of modulus_context must be at least 2.\n");
+        }
+    }
+
+    SECTION("Arithmetic Agrees With int_mod<N>")
+    {
+        REQUIRE(im::dynamic_int_mod(mod13, -1) == 12);
+        REQUIRE(im::dynamic_int_mod(mod13, 12) + im::dynamic_int_mod(mod13, 20) == 6);
+        REQUIRE(im::dynamic_int_mod(mod13, 3) - 5 == 11);
+        REQUIRE(3 - im::dynamic_int_mod(mod13, 5) == 11);
+        REQUIRE(-im::dynamic_int_mod(mod13, 0) == 0);
+        REQUIRE(im::dynamic_int_mod(mod13, 12) * im::dynamic_int_mod(mod13, 20) == 6);
+        REQUIRE(im::dynamic_int_mod(mod13, 12) / 20 == 11);
+        REQUIRE(420 / im::dynamic_int_mod(mod1337, 69) == 413);
+        REQUIRE(im::dynamic_int_mod(mersenne61, -1) * im::dynamic_int_mod(mersenne61, -1) == 1);
+        REQUIRE(im::dynamic_int_mod(mersenne61, 2).inverse() == (1ll << 60));
+
+        im::int_mod<998244353> x{ 3 };
+        im::modulus_context const ntt_prime{ 998244353 };
+        im::dynamic_int_mod y{ ntt_prime, 3 };
+
+        for( auto i{ 0 }; i < 1000; ++i )
+        {
+            x *= x + i;
+            y *= y + i;
+            REQUIRE(x.value() == y.value());
+        }
+
+        try
+        {
+            im::dynamic_int_mod(mod1337, 420) / im::dynamic_int_mod(mod1337, 7);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "7 is not invertible modulo 1337 because gcd(7, 1337) = 7, which is not 1.\n");
+        }
+    }
+}
+
+TEST_CASE("Testing batch_inverse()")
+{
+    SECTION("Inverts Every Element")
+    {
+        std::vector<im::int_mod<13>> values{ 1, 2, 3, 12, 7 };
+        REQUIRE(im::batch_inverse(std::span{ values }) == values.size());
+        REQUIRE(values == std::vector<im::int_mod<13>>{ 1, 7, 9, 12, 2 });
+
+        std::vector<im::int_mod<1337>> single{ 69 };
+        REQUIRE(im::batch_inverse(std::span{ single }) == 1);
+        REQUIRE(single[0] == 1182);
+
+        std::vector<im::int_mod<13>> empty;
+        REQUIRE(im::batch_inverse(std::span{ empty }) == 0);
+    }
+
+    SECTION("Reports the First Non-Invertible Element Without Modifying the Input")
+    {
+        std::vector<im::int_mod<12>> values{ 1, 5, 4, 7, 6 };
+        REQUIRE(im::batch_inverse(std::span{ values }) == 2);
+        REQUIRE(values == std::vector<im::int_mod<12>>{ 1, 5, 4, 7, 6 });
+    }
+
+    SECTION("Works for Every Backend")
+    {
+        std::vector<im::montgomery_int_mod<998244353>> montgomery{ 2, 3, 5, -1 };
+        REQUIRE(im::batch_inverse(std::span{ montgomery }) == 4);
+        REQUIRE(montgomery[0] * 2 == 1);
+        REQUIRE(montgomery[1] * 3 == 1);
+        REQUIRE(montgomery[2] * 5 == 1);
+        REQUIRE(montgomery[3] == -1);
+
+        std::vector<im::int_mod<2305843009213693951, im::barrett_reduction>> barrett{ 2, 3 };
+        REQUIRE(im::batch_inverse(std::span{ barrett }) == 2);
+        REQUIRE(barrett[0] == (1ll << 60));
+        REQUIRE(barrett[1] * 3 == 1);
+
+        im::modulus_context const mod1337{ 1337 };
+        std::vector<im::dynamic_int_mod> dynamic{ { mod1337, 69 }, { mod1337, 420 } };
+        REQUIRE(im::batch_inverse(std::span{ dynamic }) == 1);
+        REQUIRE(dynamic[0] == 69);
+    }
+}
+
+TEST_CASE("Testing try_inverse()/checked_div()")
+{
+    SECTION("Invertible Values")
+    {
+        REQUIRE(im::int_mod<13>(12).try_inverse() == im::int_mod<13>(12));
+        REQUIRE(im::int_mod<13>(12).checked_div(im::int_mod<13>(20)) == im::int_mod<13>(11));
+        REQUIRE(im::int_mod<1337>(420).checked_div(69) == im::int_mod<1337>(413));
+        REQUIRE(im::montgomery_int_mod<15>(7).try_inverse() == im::montgomery_int_mod<15>(13));
+        REQUIRE(im::impl_details::try_inverse_of<1000000000>(1337) == 325355273);
+
+        im::modulus_context const mod1337{ 1337 };
+        REQUIRE(im::dynamic_int_mod(mod1337, 420).checked_div(69) == im::dynamic_int_mod(mod1337, 413));
+    }
+
+    SECTION("Non-Invertible Values Give std::nullopt")
+    {
+        REQUIRE_FALSE(im::int_mod<15>(-3).try_inverse().has_value());
+        REQUIRE_FALSE(im::int_mod<15>(-1).checked_div(im::int_mod<15>(-3)).has_value());
+        REQUIRE_FALSE(im::int_mod<2>(1).checked_div(123456).has_value());
+        REQUIRE_FALSE(im::montgomery_int_mod<15>(5).try_inverse().has_value());
+        REQUIRE_FALSE(im::impl_details::try_inverse_of<1234>(2).has_value());
+
+        im::modulus_context const mod1337{ 1337 };
+        REQUIRE_FALSE(im::dynamic_int_mod(mod1337, 420).try_inverse().has_value());
+    }
+
+    SECTION("Usable in Constant Expressions")
+    {
+        static_assert(im::int_mod<13>(12).try_inverse() == im::int_mod<13>(12));
+        static_assert(!im::int_mod<15>(-3).try_inverse());
+    }
+}
+
+TEST_CASE("Testing pow()")
+{
+    SECTION("Runtime Exponents")
+    {
+        REQUIRE(im::int_mod<5>(3).pow(8) == 1);
+        REQUIRE(im::int_mod<17>(7).pow(81) == 7);
+        REQUIRE(im::int_mod<1337>(420).pow(69) == 567);
+        REQUIRE(im::int_mod<1337>(420).pow(0) == 1);
+        REQUIRE(im::int_mod<1000000000>(123456789).pow(987654321) == 974933589);
+        REQUIRE(im::int_mod<998244353, im::barrett_reduction>(3).pow(998244352) == 1);
+
+        im::modulus_context const mod1337{ 1337 };
+        REQUIRE(im::dynamic_int_mod(mod1337, 420).pow(69) == 567);
+
+        try
+        {
+            im::int_mod<13>(2).pow(-1);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Exponent must be non-negative.");
+        }
+    }
+
+    SECTION("Compile-Time Exponents")
+    {
+        REQUIRE(im::int_mod<17>(7).pow<81>() == 7);
+        REQUIRE(im::int_mod<1337>(420).pow<0>() == 1);
+        REQUIRE(im::int_mod<1337>(420).pow<1>() == 420);
+        REQUIRE(im::int_mod<1000000000>(123456789).pow<987654321>() == 974933589);
+        REQUIRE(im::montgomery_int_mod<998244353>(3).pow<(998244353 - 1) / 2>() == -1);
+        REQUIRE(im::int_mod<2305843009213693951>(3).pow<2305843009213693950>() == 1);
+
+        static_assert(im::int_mod<1337>(420).pow<69>() == 567);
+        static_assert(im::int_mod<1337>(420).pow(69) == 567);
+    }
+}
+
+TEST_CASE("Testing fixed_base_pow<T>")
+{
+    SECTION("Agrees With pow() for Every Window Width")
+    {
+        for( auto w{ 1 }; w <= 8; ++w )
+        {
+            im::fixed_base_pow const g{ im::int_mod<1000000000>(123456789), w };
+
+            REQUIRE(g.pow(0) == 1);
+            REQUIRE(g.pow(1) == 123456789);
+            REQUIRE(g.pow(987654321) == 974933589);
+            REQUIRE(g.pow(INT64_MAX) == im::int_mod<1000000000>(123456789).pow(INT64_MAX));
+        }
+    }
+
+    SECTION("Works for Every Backend")
+    {
+        im::fixed_base_pow const g{ im::montgomery_int_mod<998244353>(3), 6 };
+        REQUIRE(g.pow(998244352) == 1);
+        REQUIRE(g.pow((998244353 - 1) / 2) == -1);
+        REQUIRE(g.table_size() == 11 * 63);
+
+        im::modulus_context const mod1337{ 1337 };
+        im::fixed_base_pow const h{ im::dynamic_int_mod(mod1337, 420) };
+        REQUIRE(h.pow(69) == 567);
+    }
+
+    SECTION("Rejects Exponents Outside the Table")
+    {
+        im::fixed_base_pow const g{ im::int_mod<13>(2), 4, 8 };
+        REQUIRE(g.pow(255) == im::int_mod<13>(2).pow(255));
+
+        try
+        {
+            g.pow(256);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Exponent 256 does not fit in the 8 bits of this fixed_base_pow table.\n");
+        }
+
+        try
+        {
+            im::fixed_base_pow{ im::int_mod<13>(2), 17 };
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Window width 17 of fixed_base_pow must be between 1 and 16.\n");
+        }
+    }
+}
+
+TEST_CASE("Testing multi_pow()")
+{
+    using F = im::int_mod<998244353>;
+
+    SECTION("Straus and Pippenger Agree With Separate Powers")
+    {
+        for( std::size_t k : { 1, 2, 3, 17, 100, 600 } )
+        {
+            std::vector<F> bases;
+            std::vector<im::s64> exponents;
+            F expected{ 1 };
+
+            for( std::size_t i{ 0 }; i < k; ++i )
+            {
+                bases.emplace_back(static_cast<im::s64>(3 + 7 * i));
+                exponents.push_back(static_cast<im::s64>((i * 2654435761u) % 998244352u));
+                expected *= bases.back().pow(exponents.back());
+            }
+
+            REQUIRE(im::multi_pow_straus(std::span{ bases }, exponents) == expected);
+            REQUIRE(im::multi_pow_pippenger(std::span{ bases }, exponents) == expected);
+            REQUIRE(im::multi_pow(std::span{ bases }, exponents) == expected);
+        }
+    }
+
+    SECTION("Edge Cases")
+    {
+        std::vector<F> const bases{ 2, 3 };
+
+        REQUIRE(im::multi_pow(std::span{ bases }, std::vector<im::s64>{ 0, 0 }) == 1);
+        REQUIRE(im::multi_pow_pippenger(std::span{ bases }, std::vector<im::s64>{ 0, 1 }) == 3);
+        REQUIRE(im::multi_pow_straus(std::span{ bases }, std::vector<im::s64>{ INT64_MAX, 0 }) == F(2).pow(INT64_MAX));
+
+        try
+        {
+            im::multi_pow(std::span{ bases }, std::vector<im::s64>{ 1 });
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "multi_pow was given 2 bases but 1 exponents.\n");
+        }
+    }
+
+    SECTION("Works for Every Backend")
+    {
+        std::vector<im::montgomery_int_mod<2305843009213693951>> const bases{ 2, 3, 5 };
+        REQUIRE(im::multi_pow(std::span{ bases }, std::vector<im::s64>{ 61, 2305843009213693950, 0 }) == 1);
+
+        im::modulus_context const mod1337{ 1337 };
+        std::vector<im::dynamic_int_mod> const dynamic{ { mod1337, 420 }, { mod1337, 2 } };
+        REQUIRE(im::multi_pow_pippenger(std::span{ dynamic }, std::vector<im::s64>{ 69, 1 }) == 567 * 2);
+    }
+}
+
+TEST_CASE("Testing vector kernels")
+{
+    auto const levels = []
+    {
+        std::vector<im::simd_level> result{ im::simd_level::scalar };
+
+        if( im::detected_simd_level() != im::simd_level::scalar )
+        {
+            result.push_back(im::simd_level::avx2);
+        }
+
+        if( im::detected_simd_level() == im::simd_level::avx512 )
+        {
+            result.push_back(im::simd_level::avx512);
+        }
+
+        return result;
+    }();
+
+    auto const check = [&]<typename F>(F)
+    {
+        for( std::size_t size : { 0, 1, 7, 8, 9, 100 } )
+        {
+            std::vector<F> a, b, c;
+
+            for( std::size_t i{ 0 }; i < size; ++i )
+            {
+                a.emplace_back(static_cast<im::s64>(i * 0x9E3779B97F4A7C15u >> 1));
+                b.emplace_back(-static_cast<im::s64>(i * 0xC2B2AE3D27D4EB4Fu >> 2));
+                c.emplace_back(static_cast<im::s64>(i) - 50);
+            }
+
+            a.emplace_back(-1);
+            b.emplace_back(-1);
+            c.emplace_back(-1);
+
+            for( auto level : levels )
+            {
+                std::vector<F> out(a.size());
+
+                im::vector_add(a, b, std::span{ out }, level);
+                for( std::size_t i{ 0 }; i < a.size(); ++i ) REQUIRE(out[i] == a[i] + b[i]);
+
+                im::vector_sub(a, b, std::span{ out }, level);
+                for( std::size_t i{ 0 }; i < a.size(); ++i ) REQUIRE(out[i] == a[i] - b[i]);
+
+                im::vector_mul(a, b, std::span{ out }, level);
+                for( std::size_t i{ 0 }; i < a.size(); ++i ) REQUIRE(out[i] == a[i] * b[i]);
+
+                im::vector_fma(a, b, c, std::span{ out }, level);
+                for( std::size_t i{ 0 }; i < a.size(); ++i ) REQUIRE(out[i] == a[i] * b[i] + c[i]);
+
+                im::vector_scale(a, c.back(), std::span{ out }, level);
+                for( std::size_t i{ 0 }; i < a.size(); ++i ) REQUIRE(out[i] == a[i] * c.back());
+            }
+        }
+    };
+
+    SECTION("Every Level Matches the Scalar Operators")
+    {
+        check(im::int_mod<998244353>{});
+        check(im::int_mod<2147483647>{});
+        check(im::int_mod<1337>{});
+        check(im::int_mod<1000000006>{});
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{});
+    }
+
+    SECTION("In-Place Operation")
+    {
+        std::vector<im::int_mod<97>> a{ 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        im::vector_mul(a, a, std::span{ a });
+        im::vector_add(a, a, std::span{ a });
+
+        REQUIRE(a == std::vector<im::int_mod<97>>{ 2, 8, 18, 32, 50, 72, 98, 128, 162 });
+    }
+
+    SECTION("Mismatched Lengths")
+    {
+        std::vector<im::int_mod<97>> a(3), out(4);
+
+        try
+        {
+            im::vector_add(a, a, std::span{ out });
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Vector kernel spans have different lengths (4 and 3).\n");
+        }
+    }
+}
+
+TEST_CASE("Testing ntt_plan<N>")
+{
+    SECTION("Compile-Time Roots of Unity")
+    {
+        static_assert(im::ntt_traits<998244353>::primitive_root == 3);
+        static_assert(im::ntt_traits<998244353>::max_log_size == 23);
+        static_assert(im::ntt_traits<7340033>::primitive_root == 3);
+        static_assert(im::ntt_traits<7340033>::max_log_size == 20);
+        static_assert(im::ntt_traits<1337>::primitive_root == 0);
+        static_assert(im::ntt_traits<561>::primitive_root == 0);
+
+        using traits = im::ntt_traits<998244353>;
+        REQUIRE(im::int_mod<998244353>{ traits::root_of_unity(23) }.pow(1 << 22) == -1);
+        REQUIRE(im::int_mod<998244353>{ traits::root_of_unity(1) } == -1);
+    }
+
+    auto const check = [&]<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>, std::size_t const max_naive)
+    {
+        using F = im::int_mod<N, Reduction>;
+
+        for( std::size_t size{ 1 }; size <= 4096; size *= 2 )
+        {
+            im::ntt_plan<N, Reduction> const plan{ size };
+            std::vector<F> values(size);
+
+            for( std::size_t i{ 0 }; i < size; ++i )
+            {
+                values[i] = static_cast<im::s64>(i * 0x9E3779B97F4A7C15u >> 1);
+            }
+
+            std::vector<F> transformed(size);
+            plan.forward(values, std::span{ transformed });
+
+            if( size <= max_naive )
+            {
+                F const root{ im::ntt_traits<N>::root_of_unity(std::countr_zero(size)) };
+
+                for( std::size_t k{ 0 }; k < size; ++k )
+                {
+                    F expected{ 0 };
+
+                    for( std::size_t j{ 0 }; j < size; ++j )
+                    {
+                        expected += values[j] * root.pow(static_cast<im::s64>(j * k));
+                    }
+
+                    REQUIRE(transformed[k] == expected);
+                }
+            }
+
+            plan.inverse(std::span{ transformed });
+            REQUIRE(transformed == values);
+        }
+    };
+
+    SECTION("Matches the Naive Transform and Round Trips")
+    {
+        check(im::int_mod<998244353>{}, 64);
+        check(im::int_mod<7340033, im::barrett_reduction>{}, 32);
+        check(im::int_mod<4179340454199820289>{}, 16);
+    }
+
+    SECTION("Cyclic Convolution")
+    {
+        using F = im::int_mod<998244353>;
+
+        im::ntt_plan<998244353> const plan{ 8 };
+        std::vector<F> a{ 1, 2, 3, 0, 0, 0, 0, 0 };
+        std::vector<F> b{ 4, 5, 6, 0, 0, 0, 0, 0 };
+
+        plan.forward(std::span{ a });
+        plan.forward(std::span{ b });
+
+        for( std::size_t i{ 0 }; i < 8; ++i )
+        {
+            a[i] *= b[i];
+        }
+
+        plan.inverse(std::span{ a });
+
+        REQUIRE(a == std::vector<F>{ 4, 13, 28, 27, 18, 0, 0, 0 });
+    }
+
+    SECTION("Invalid Sizes")
+    {
+        REQUIRE(im::ntt_plan<998244353>::max_size() == std::size_t{ 1 } << 23);
+
+        try
+        {
+            im::ntt_plan<998244353> const plan{ 12 };
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "NTT size 12 must be a power of two no larger than 2^23 modulo 998244353.\n");
+        }
+
+        try
+        {
+            im::ntt_plan<7340033> const plan{ std::size_t{ 1 } << 21 };
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "NTT size 2097152 must be a power of two no larger than 2^20 modulo 7340033.\n");
+        }
+
+        try
+        {
+            std::vector<im::int_mod<998244353>> values(3);
+            im::ntt_plan<998244353>{ 4 }.forward(std::span{ values });
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "ntt_plan of size 4 was given 3 values.\n");
+        }
+    }
+}
+
+TEST_CASE("Testing polynomial<int_mod<N>>")
+{
+    auto const random_polynomial = []<typename F>(F, std::size_t const size, std::size_t const seed)
+    {
+        std::vector<F> coefficients(size);
+
+        for( std::size_t i{ 0 }; i < size; ++i )
+        {
+            coefficients[i] = static_cast<im::s64>((i + seed) * 0x9E3779B97F4A7C15u >> 3);
+        }
+
+        coefficients.back() = 1;
+
+        return im::polynomial<F>{ coefficients };
+    };
+
+    SECTION("Basics")
+    {
+        using P = im::polynomial<im::int_mod<97>>;
+
+        P const p{ 1, 2, 3, 0, 0 };
+
+        REQUIRE(p.degree() == 2);
+        REQUIRE(P{ }.degree() == -1);
+        REQUIRE(P{ 0, 0 }.is_zero());
+        REQUIRE(p[1] == 2);
+        REQUIRE(p[7] == 0);
+        REQUIRE(p(2) == 17);
+        REQUIRE(p + P{ -1, -2, -3 } == P{ });
+        REQUIRE(p - P{ 1 } == P{ 0, 2, 3 });
+        REQUIRE(p * P{ 1, 1 } == P{ 1, 3, 5, 3 });
+        REQUIRE(p * im::int_mod<97>{ 2 } == P{ 2, 4, 6 });
+        REQUIRE(p.derivative() == P{ 2, 6 });
+        REQUIRE(-p == P{ 96, 95, 94 });
+    }
+
+    auto const check_multiply = [&]<typename F>(F)
+    {
+        using P = im::polynomial<F>;
+
+        for( auto [m, n] : { std::pair{ 1, 1 }, { 5, 40 }, { 33, 33 }, { 70, 65 }, { 100, 300 }, { 257, 1000 } } )
+        {
+            P const a{ random_polynomial(F{ }, m, 1) };
+            P const b{ random_polynomial(F{ }, n, 2) };
+
+            auto const expected = im::impl_details::multiply_schoolbook(std::span<F const>{ a.coefficients() }, std::span<F const>{ b.coefficients() });
+            auto const karatsuba = im::impl_details::multiply_karatsuba<F>(a.coefficients(), b.coefficients(), 4);
+
+            REQUIRE(karatsuba == expected);
+            REQUIRE((a * b).coefficients() == expected);
+        }
+    };
+
+    SECTION("Schoolbook, Karatsuba and NTT Agree")
+    {
+        check_multiply(im::int_mod<998244353>{ });
+        check_multiply(im::int_mod<1000000007>{ });
+        check_multiply(im::int_mod<1337, im::barrett_reduction>{ });
+    }
+
+    SECTION("Three-Prime NTT Matches Schoolbook")
+    {
+        static_assert(im::impl_details::three_prime_max_terms<1000000007>() == std::size_t{ 1 } << 23);
+        static_assert(im::impl_details::three_prime_max_terms<4294967291>() > 4000000);
+        static_assert(im::impl_details::three_prime_max_terms<2305843009213693951>() == 0);
+
+        auto const check = [&]<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>)
+        {
+            using F = im::int_mod<N, Reduction>;
+
+            for( auto [m, n] : { std::pair{ 1, 1 }, { 5, 40 }, { 257, 1000 }, { 1500, 1500 } } )
+            {
+                auto const a = random_polynomial(F{ }, m, 3).coefficients();
+                auto const b = random_polynomial(F{ }, n, 4).coefficients();
+
+                auto const expected = im::impl_details::multiply_karatsuba<F>(a, b, 32);
+
+                REQUIRE(im::impl_details::multiply_three_primes<N, Reduction>(a, b, false) == expected);
+                REQUIRE(im::impl_details::multiply_three_primes<N, Reduction>(a, b, true) == expected);
+            }
+
+            // Every coefficient -1 makes each product coefficient as large as it can be before reduction.
+            std::vector<F> const worst(2000, F{ -1 });
+            REQUIRE(im::impl_details::multiply_three_primes<N, Reduction>(worst, worst, false)
+                    == im::impl_details::multiply_karatsuba<F>(worst, worst, 32));
+        };
+
+        check(im::int_mod<2>{ });
+        check(im::int_mod<1000000007>{ });
+        check(im::int_mod<1000000000, im::barrett_reduction>{ });
+        check(im::int_mod<4294967291>{ });
+
+        using P = im::polynomial<im::int_mod<1000000007>>;
+        P const a{ random_polynomial(im::int_mod<1000000007>{ }, P::three_prime_threshold, 5) };
+        P const b{ random_polynomial(im::int_mod<1000000007>{ }, P::three_prime_threshold + 100, 6) };
+
+        REQUIRE((a * b).coefficients() == im::impl_details::multiply_karatsuba<im::int_mod<1000000007>>(a.coefficients(), b.coefficients(), 32));
+    }
+
+    SECTION("Inverse and Division")
+    {
+        using F = im::int_mod<998244353>;
+        using P = im::polynomial<F>;
+
+        P const f{ random_polynomial(F{ }, 300, 3) };
+        P const g{ f.inverse(500) };
+
+        REQUIRE(g.size() <= 500);
+        REQUIRE((f * g).truncate(500) == P{ 1 });
+
+        for( std::size_t divisor_size : { 1, 10, 100, 250 } )
+        {
+            P const a{ random_polynomial(F{ }, 400, 4) };
+            P const b{ random_polynomial(F{ }, divisor_size, 5) };
+            auto const [q, r] = a.divide(b);
+
+            REQUIRE(r.degree() < b.degree());
+            REQUIRE(q * b + r == a);
+            REQUIRE(a / b == q);
+            REQUIRE(a % b == r);
+        }
+
+        REQUIRE(P{ 1, 2 }.divide(P{ 1, 2, 3 }).second == P{ 1, 2 });
+
+        try
+        {
+            P{ 1 }.divide(P{ });
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Polynomial division by zero.");
+        }
+
+        try
+        {
+            im::polynomial<im::int_mod<10>>{ 2, 1 }.inverse(4);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Power series inverse requires an invertible constant term, but gcd(2, 10) is not 1.\n");
+        }
+    }
+
+    SECTION("Multipoint Evaluation and Interpolation")
+    {
+        using F = im::int_mod<998244353>;
+        using P = im::polynomial<F>;
+
+        for( std::size_t size : { 1, 7, 200, 600 } )
+        {
+            P const p{ random_polynomial(F{ }, size, 6) };
+            std::vector<F> points(size);
+
+            for( std::size_t i{ 0 }; i < size; ++i )
+            {
+                points[i] = static_cast<im::s64>(3 * i * i + 1);
+            }
+
+            auto const values = p.evaluate(points);
+
+            for( std::size_t i{ 0 }; i < size; ++i )
+            {
+                REQUIRE(values[i] == p(points[i]));
+            }
+
+            REQUIRE(P::interpolate(points, values) == p);
+        }
+
+        std::vector<F> const points{ 1, 2, 1 };
+        std::vector<F> const values{ 1, 2, 3 };
+
+        try
+        {
+            P::interpolate(points, values);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "interpolate requires the differences of the points to be invertible.\n");
+        }
+    }
+}
+
+TEST_CASE("Testing matrix<int_mod<N>>")
+{
+    SECTION("Basics")
+    {
+        using M = im::matrix<im::int_mod<97>>;
+
+        M const key{ { 6, 24, 1 }, { 13, 16, 10 }, { 20, 17, 15 } };
+        M const message{ { 0 }, { 2 }, { 19 } };
+
+        REQUIRE(key.rows() == 3);
+        REQUIRE(key.cols() == 3);
+        REQUIRE(key(1, 2) == 10);
+        REQUIRE(key * message == M{ { 67 }, { 28 }, { 28 } });
+        REQUIRE(key * M::identity(3) == key);
+        REQUIRE(key.transpose()(2, 0) == 1);
+        REQUIRE(key + key == key * im::int_mod<97>{ 2 });
+        REQUIRE(key - key == M(3, 3));
+
+        try
+        {
+            M const bad{ { 1, 2 }, { 3 } };
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Matrix rows must all have the same length.\n");
+        }
+
+        try
+        {
+            static_cast<void>(message * key);
+            FAIL("Expected std::invalid_argument.");
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Cannot multiply a 3x1 matrix by a 3x3 matrix.\n");
+        }
+    }
+
+    auto const check = [&]<typename F>(F)
+    {
+        using M = im::matrix<F>;
+
+        for( auto [m, k, n] : { std::tuple{ 1, 1, 1 }, { 5, 7, 3 }, { 33, 300, 257 }, { 70, 40, 129 }, { 131, 260, 129 } } )
+        {
+            M a(m, k), b(k, n);
+
+            for( std::size_t i{ 0 }; i < a.rows(); ++i )
+            {
+                for( std::size_t j{ 0 }; j < a.cols(); ++j )
+                {
+                    a(i, j) = -static_cast<im::s64>(i * 31 + j * 17 + 1);
+                }
+            }
+
+            for( std::size_t i{ 0 }; i < b.rows(); ++i )
+            {
+                for( std::size_t j{ 0 }; j < b.cols(); ++j )
+                {
+                    b(i, j) = static_cast<im::s64>((i * 0x9E3779B97F4A7C15u + j) >> 2);
+                }
+            }
+
+            M expected(m, n);
+
+            for( std::size_t i{ 0 }; i < a.rows(); ++i )
+            {
+                for( std::size_t p{ 0 }; p < a.cols(); ++p )
+                {
+                    for( std::size_t j{ 0 }; j < b.cols(); ++j )
+                    {
+                        expected(i, j) += a(i, p) * b(p, j);
+                    }
+                }
+            }
+
+            REQUIRE(M::multiply(a, b, 1) == expected);
+            REQUIRE(M::multiply(a, b, 3) == expected);
+        }
+    };
+
+    SECTION("Blocked Product Matches the Naive Product")
+    {
+        check(im::int_mod<97>{ });
+        check(im::int_mod<998244353, im::barrett_reduction>{ });
+        check(im::int_mod<3037000493>{ });
+        check(im::int_mod<2305843009213693951>{ });
+        check(im::int_mod<9223372036854775783>{ });
+    }
+
+    SECTION("Strassen-Winograd Recursion Matches the Blocked Product")
+    {
+        using T = im::int_mod<9223372036854775783>;
+
+        for( auto [m, k, n] : { std::tuple{ 2, 2, 2 }, { 7, 5, 9 }, { 16, 16, 16 }, { 45, 38, 51 } } )
+        {
+            std::vector<T> a(m * k), b(k * n), c(m * n), expected(m * n);
+
+            for( std::size_t i{ 0 }; i < a.size(); ++i )
+            {
+                a[i] = static_cast<im::s64>(i * 0x9E3779B97F4A7C15u);
+            }
+
+            for( std::size_t i{ 0 }; i < b.size(); ++i )
+            {
+                b[i] = -static_cast<im::s64>(i * 7919 + 3);
+            }
+
+            for( std::size_t cutoff : { 2, 3, 8 } )
+            {
+                im::impl_details::scratch_arena<T> arena{ im::impl_details::winograd_scratch(m, k, n, cutoff) };
+                im::impl_details::winograd(a.data(), k, b.data(), n, c.data(), n, m, k, n, cutoff, arena, 1);
+                im::impl_details::gemm(a.data(), k, b.data(), n, expected.data(), n, m, k, n, im::impl_details::gemm_mode::assign, 1);
+
+                REQUIRE(c == expected);
+            }
+        }
+    }
+
+    SECTION("Lazy Reduction Bounds")
+    {
+        static_assert(im::impl_details::lazy_sum_traits<97>::use_narrow);
+        static_assert(im::impl_details::lazy_sum_traits<998244353>::chunk == 18);
+        static_assert(!im::impl_details::lazy_sum_traits<3037000493>::use_narrow);
+        static_assert(im::impl_details::lazy_sum_traits<9223372036854775783>::chunk == 4);
+    }
+}
+
+TEST_CASE("Testing matrix<int_mod<N>> elimination")
+{
+    // Deterministic pseudo-random entries, so failures reproduce.
+    auto const fill = [](auto &m, std::uint64_t seed)
+    {
+        for( std::size_t i{ 0 }; i < m.rows(); ++i )
+        {
+            for( std::size_t j{ 0 }; j < m.cols(); ++j )
+            {
+                seed = seed * 6364136223846793005u + 1442695040888963407u;
+                m(i, j) = static_cast<im::s64>(seed >> 2);
+            }
+        }
+    };
+
+    SECTION("Small Determinants")
+    {
+        using M = im::matrix<im::int_mod<97>>;
+
+        REQUIRE(M{ { 3, 5 }, { 7, 11 } }.determinant() == 33 - 35);
+        REQUIRE(M{ { 0, 1 }, { 1, 0 } }.determinant() == -1);
+        REQUIRE(M{ { 2, 9, 4 }, { 0, 5, 6 }, { 0, 0, 7 } }.determinant() == 70);
+        REQUIRE(M{ { 1, 2 }, { 2, 4 } }.determinant() == 0);
+        REQUIRE(M::identity(100).determinant() == 1);
+        REQUIRE(M{ }.determinant() == 1);
+
+        // Neither entry of the first column is a unit modulo 6, so the column is folded into its gcd.
+        REQUIRE(im::matrix<im::int_mod<6>>{ { 2, 3 }, { 3, 2 } }.determinant() == 4 - 9);
+        REQUIRE(im::matrix<im::int_mod<1000>>{ { 10, 4, 6 }, { 25, 8, 1 }, { 4, 2, 50 } }.determinant()
+                == 10 * (8 * 50 - 1 * 2) - 4 * (25 * 50 - 1 * 4) + 6 * (25 * 2 - 8 * 4));
+
+        try
+        {
+            std::ignore = M(2, 3).determinant();
+            REQUIRE(false);
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Determinant requires a square matrix, but this one is 2x3.\n");
+        }
+    }
+
+    auto const check = [&]<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>, std::size_t const n)
+    {
+        using M = im::matrix<im::int_mod<N, Reduction>>;
+
+        M a(n, n);
+        M b(n, n);
+        fill(a, n);
+        fill(b, n + 1000);
+
+        REQUIRE((a * b).determinant() == a.determinant() * b.determinant());
+        REQUIRE(a.determinant(1) == a.determinant(3));
+
+        // Unit triangular factors give an invertible product even when most entries share factors with N.
+        M lower(n, n);
+        M upper(n, n);
+        fill(lower, n + 2000);
+        fill(upper, n + 3000);
+
+        for( std::size_t i{ 0 }; i < n; ++i )
+        {
+            for( std::size_t j{ i }; j < n; ++j )
+            {
+                lower(i, j) = i == j ? 1 : 0;
+                upper(j, i) = i == j ? N - 1 : 0;
+            }
+        }
+
+        M const c{ lower * upper };
+        M const inverse{ c.inverse(3) };
+
+        REQUIRE(c * inverse == M::identity(n));
+        REQUIRE(inverse * c == M::identity(n));
+        REQUIRE(c.inverse(1) == inverse);
+        REQUIRE(c.rank() == n);
+    };
+
+    SECTION("Determinants Are Multiplicative and Inverses Invert")
+    {
+        for( std::size_t n : { 1, 2, 17, 64, 65, 150 } )
+        {
+            check(im::int_mod<998244353>{ }, n);
+            check(im::int_mod<1000>{ }, n);
+        }
+
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{ }, 70);
+        check(im::int_mod<9223372036854775783>{ }, 70);
+    }
+
+    SECTION("Singular Matrices")
+    {
+        using M = im::matrix<im::int_mod<4>>;
+
+        REQUIRE_FALSE(M{ { 2, 0 }, { 0, 1 } }.try_inverse());
+        REQUIRE_FALSE(M(2, 3).try_inverse());
+        REQUIRE(M{ { 3, 0 }, { 1, 1 } }.try_inverse() == M{ { 3, 0 }, { 1, 1 } });
+
+        using M6 = im::matrix<im::int_mod<6>>;
+        M6 const c{ { 2, 3 }, { 3, 2 } };
+        REQUIRE(c * c.inverse() == M6::identity(2));
+
+        try
+        {
+            std::ignore = M{ { 2, 0 }, { 0, 1 } }.inverse();
+            REQUIRE(false);
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Matrix is not invertible modulo 4.\n");
+        }
+
+        try
+        {
+            std::ignore = M(2, 3).inverse();
+            REQUIRE(false);
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Cannot invert a 2x3 matrix.\n");
+        }
+    }
+
+    SECTION("Rank")
+    {
+        using F = im::matrix<im::int_mod<998244353>>;
+
+        F a(40, 7);
+        F b(7, 90);
+        fill(a, 1);
+        fill(b, 2);
+
+        REQUIRE((a * b).rank() == 7);
+        REQUIRE((a * b).transpose().rank(3) == 7);
+        REQUIRE(F(5, 5).rank() == 0);
+        REQUIRE(F{ { 1, 2 }, { 2, 4 } }.rank() == 1);
+
+        // For composite N the rank counts the rows of the Howell form.
+        REQUIRE(im::matrix<im::int_mod<4>>{ { 2 } }.rank() == 1);
+        REQUIRE(im::matrix<im::int_mod<4>>{ { 2, 1 } }.rank() == 2);
+        REQUIRE(im::matrix<im::int_mod<4>>{ { 2, 0 }, { 0, 2 } }.rank() == 2);
+        REQUIRE(im::matrix<im::int_mod<6>>{ { 1, 2 }, { 2, 4 } }.rank() == 1);
+        REQUIRE(im::matrix<im::int_mod<6>>{ { 2 }, { 3 } }.rank() == 1);
+        REQUIRE(im::matrix<im::int_mod<12>>{ { 4, 1, 0 }, { 0, 3, 6 } }.rank() == 3);
+    }
+}
+
+TEST_CASE("Testing int_mod_accumulator<N>")
+{
+    SECTION("Capacity")
+    {
+        static_assert(im::int_mod_accumulator<998244353>::capacity == 18);
+        static_assert(std::is_same_v<im::int_mod_accumulator<97>::sum_type, im::u64>);
+        static_assert(std::is_same_v<im::int_mod_accumulator<2305843009213693951>::sum_type, im::u128>);
+        static_assert(im::int_mod_accumulator<9223372036854775783>::capacity == 4);
+    }
+
+    auto const check = []<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>)
+    {
+        using T = im::int_mod<N, Reduction>;
+
+        // Residues near N - 1 make every product as large as possible.
+        std::vector<T> a(1000), b(1000);
+
+        for( std::size_t i{ 0 }; i < a.size(); ++i )
+        {
+            a[i] = -1 - static_cast<im::s64>(i % 3);
+            b[i] = -1 - static_cast<im::s64>(i % 5);
+        }
+
+        T expected{ 7 };
+        im::int_mod_accumulator<N, Reduction> sum{ T{ 7 } };
+
+        for( std::size_t i{ 0 }; i < a.size(); ++i )
+        {
+            expected += a[i] * b[i];
+            sum.add_product(a[i], b[i]);
+
+            if( i % 7 == 0 )
+            {
+                expected += a[i];
+                sum += a[i];
+            }
+
+            REQUIRE(sum.value() == expected);
+        }
+
+        T dot_expected{ 0 };
+
+        for( std::size_t i{ 0 }; i < a.size(); ++i )
+        {
+            dot_expected += a[i] * b[i];
+        }
+
+        REQUIRE(im::dot(std::span<T const>{ a }, b) == dot_expected);
+        REQUIRE(sum.add_products(a, b).value() == expected + dot_expected);
+
+        sum.reset();
+        REQUIRE(sum.value() == 0);
+        REQUIRE(sum.add_products(std::span{ a }.first(1), std::span{ b }.first(1)).value() == a[0] * b[0]);
+    };
+
+    SECTION("Matches the int_mod<N> Operators")
+    {
+        check(im::int_mod<2>{ });
+        check(im::int_mod<97>{ });
+        check(im::int_mod<998244353, im::barrett_reduction>{ });
+        check(im::int_mod<4294967291>{ });
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{ });
+        check(im::int_mod<9223372036854775783>{ });
+    }
+
+    SECTION("Lengths Must Match")
+    {
+        std::vector<im::int_mod<97>> const a(3), b(2);
+
+        try
+        {
+            std::ignore = im::dot(std::span{ a }, b);
+            REQUIRE(false);
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Dot product spans have different lengths (3 and 2).\n");
+        }
+    }
+}
+
+TEST_CASE("Testing shoup_multiplier<N>")
+{
+    SECTION("Precomputed Quotient")
+    {
+        static_assert(im::shoup_multiplier<3>{ 1 }.quotient() == 6148914691236517205u);
+        static_assert(im::shoup_multiplier<97>{ 0 }.quotient() == 0);
+        static_assert((im::int_mod<97>{ 5 } * im::shoup_multiplier<97>{ 7 }) == 35);
+        static_assert(std::is_same_v<im::fixed_multiplier<998244353>, im::int_mod<998244353>>);
+        static_assert(std::is_same_v<im::fixed_multiplier<4294967291>, im::shoup_multiplier<4294967291>>);
+    }
+
+    auto const check = []<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>)
+    {
+        using T = im::int_mod<N, Reduction>;
+
+        std::vector<T> values{ 0, 1, 2, N - 1, N - 2, N / 2, N / 3 + 1 };
+
+        for( im::u64 i{ 1 }; i <= 20; ++i )
+        {
+            values.emplace_back(static_cast<im::s64>((i * 0x9E3779B97F4A7C15u) >> 1));
+        }
+
+        for( auto const w : values )
+        {
+            im::shoup_multiplier<N, Reduction> const factor{ w };
+
+            REQUIRE(factor.value() == w);
+
+            for( auto x : values )
+            {
+                REQUIRE(x * factor == x * w);
+                REQUIRE(factor * x == x * w);
+
+                T const expected{ x * w };
+                x *= factor;
+                REQUIRE(x == expected);
+            }
+        }
+    };
+
+    SECTION("Matches int_mod<N> Multiplication")
+    {
+        check(im::int_mod<2>{ });
+        check(im::int_mod<97>{ });
+        check(im::int_mod<998244353, im::barrett_reduction>{ });
+        check(im::int_mod<4294967291>{ });
+        check(im::int_mod<2305843009213693951>{ });
+        check(im::int_mod<4179340454199820289>{ });
+        check(im::int_mod<9223372036854775783>{ });
+    }
+}
+
+TEST_CASE("Testing modulus_traits<N>")
+{
+    SECTION("Primes")
+    {
+        using ntt_prime = im::modulus_traits<998244353>;
+        static_assert(ntt_prime::is_prime);
+        static_assert(ntt_prime::phi == 998244352);
+        static_assert(ntt_prime::carmichael == 998244352);
+        static_assert(ntt_prime::primitive_root == 3);
+        static_assert(ntt_prime::two_adicity == 23);
+
+        using mersenne = im::modulus_traits<2305843009213693951>;
+        static_assert(mersenne::is_prime);
+        static_assert(mersenne::primitive_root == 37);
+        static_assert(mersenne::two_adicity == 1);
+
+        static_assert(im::modulus_traits<1000000007>::primitive_root == 5);
+        static_assert(im::modulus_traits<9223372036854775783>::is_prime);
+        static_assert(im::modulus_traits<2>::is_prime);
+        static_assert(im::modulus_traits<2>::primitive_root == 1);
+        static_assert(im::modulus_traits<2>::two_adicity == 0);
+
+        REQUIRE(ntt_prime::factors().size() == 1);
+        REQUIRE(ntt_prime::factors()[0] == std::pair<im::s64, int>{ 998244353, 1 });
+    }
+
+    SECTION("Composites")
+    {
+        using semiprime = im::modulus_traits<1337>;
+        static_assert(!semiprime::is_prime);
+        static_assert(semiprime::factor_count == 2);
+        static_assert(semiprime::phi == 1140);
+        static_assert(semiprime::carmichael == 570);
+        static_assert(semiprime::primitive_root == 0);
+
+        using carmichael_number = im::modulus_traits<561>;
+        static_assert(!carmichael_number::is_prime);
+        static_assert(carmichael_number::phi == 320);
+        static_assert(carmichael_number::carmichael == 80);
+
+        using power_of_ten = im::modulus_traits<1000000000>;
+        static_assert(power_of_ten::phi == 400000000);
+        static_assert(power_of_ten::carmichael == 50000000);
+        static_assert(power_of_ten::primitive_root == 0);
+
+        // Two primes near 2^32 and 2^31: out of reach of trial division.
+        using large = im::modulus_traits<4294967291 * 2147483647>;
+        static_assert(!large::is_prime);
+        static_assert(large::phi == 4294967290 * 2147483646);
+
+        REQUIRE(large::factors().size() == 2);
+        REQUIRE(large::factors()[0] == std::pair<im::s64, int>{ 2147483647, 1 });
+        REQUIRE(large::factors()[1] == std::pair<im::s64, int>{ 4294967291, 1 });
+
+        REQUIRE(power_of_ten::factors()[0] == std::pair<im::s64, int>{ 2, 9 });
+        REQUIRE(power_of_ten::factors()[1] == std::pair<im::s64, int>{ 5, 9 });
+    }
+
+    SECTION("Cyclic Unit Groups")
+    {   // Primitive roots exist exactly for 2, 4, p^k and 2p^k.
+        static_assert(im::modulus_traits<4>::primitive_root == 3);
+        static_assert(im::modulus_traits<8>::primitive_root == 0);
+        static_assert(im::modulus_traits<8>::carmichael == 2);
+        static_assert(im::modulus_traits<9>::primitive_root == 2);
+        static_assert(im::modulus_traits<18>::primitive_root == 5);
+        static_assert(im::modulus_traits<12>::primitive_root == 0);
+
+        static_assert(im::modulus_traits<7340033>::primitive_root == im::ntt_traits<7340033>::primitive_root);
+    }
+}
+
+TEST_CASE("Testing rns<N...>")
+{
+    using R = im::rns<4611686018427387847, 4611686018427387817, 4611686018427387787, 4611686018427387761, 4611686018427387751>;
+    using S = im::rns<3, 5, 7>;
+
+    SECTION("Round Trips Through Garner's Algorithm")
+    {
+        for( im::s64 i{ 0 }; i < 105; ++i )
+        {
+            S const x{ i };
+
+            REQUIRE(x.to_string() == std::to_string(i));
+            REQUIRE(x.reduce<1000>() == i);
+            REQUIRE(x.mixed_radix() == std::array<im::s64, 3>{ i % 3, i / 3 % 5, i / 15 });
+        }
+
+        static_assert(R{ 12345 }.reduce<97>() == 12345 % 97);
+        static_assert(S{ -1 }.get<2>() == 6);
+
+        REQUIRE(R{ 0 }.to_string() == "0");
+        REQUIRE(R{ 1000000000 }.to_string() == "1000000000");
+        REQUIRE(R{ 9223372036854775807 }.to_string() == "9223372036854775807");
+    }
+
+    SECTION("Arithmetic Beyond 64 Bits")
+    {
+        R x{ 1 };
+
+        for( im::s64 const k : { 123456789012345678, 987654321098765432, 555555555555555555, 4000000000000000000 } )
+        {
+            x *= R{ k };
+        }
+
+        REQUIRE(x.to_string() == "270961402526715098223509291297735781505529306175549120000000000000000000");
+        REQUIRE(x.mixed_radix() == std::array<im::s64, 5>{ 1728735995628853175, 664020461903806915, 1322656905534732643, 2762665079004251, 0 });
+        REQUIRE(x.reduce<1000000007>() == 688139298);
+
+        REQUIRE((-R{ 1 }).to_string() == "2085924839766513500400631724051836774931991426928550329912899545337212942202404765254731755842");
+        REQUIRE(-R{ 1 } + R{ 1 } == R{ 0 });
+        REQUIRE(x - x == R{ 0 });
+        REQUIRE(x + x == x * R{ 2 });
+
+        // 2^200 + 12345.
+        R y{ 1 };
+
+        for( int i{ 0 }; i < 200; ++i )
+        {
+            y = y + y;
+        }
+
+        y += R{ 12345 };
+
+        REQUIRE(y.get<0>() == 3034214457);
+        REQUIRE(y.to_string() == "1606938044258990275541962092341162602522202993782792835313721");
+    }
+}
+
+TEST_CASE("Testing int_mod<N>::sqrt()")
+{
+    auto check = []<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>)
+    {
+        using T = im::int_mod<N, Reduction>;
+
+        std::vector<T> values;
+
+        for( im::s64 i{ 0 }; i < 200; ++i )
+        {
+            values.push_back(T{ i * 7919 + i * i });
+        }
+
+        auto const roots = im::batch_sqrt(values);
+
+        for( std::size_t i{ 0 }; i < values.size(); ++i )
+        {
+            T const a{ values[i] };
+            auto const root = a.sqrt();
+
+            REQUIRE(roots[i] == root);
+            REQUIRE((a * a).sqrt().has_value());
+            REQUIRE(*(a * a).sqrt() == (a.value() <= N / 2 ? a : -a));
+
+            if( root )
+            {
+                REQUIRE(*root * *root == a);
+                REQUIRE(root->value() <= N / 2);
+            }
+            else
+            {
+                REQUIRE(a.template pow<(N - 1) / 2>() == -1);
+            }
+        }
+    };
+
+    SECTION("Primes 3 mod 4")
+    {
+        check(im::int_mod<3>{ });
+        check(im::int_mod<1000000007>{ });
+        check(im::int_mod<2305843009213693951>{ });
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{ });
+    }
+
+    SECTION("Primes 5 mod 8")
+    {
+        check(im::int_mod<5>{ });
+        check(im::int_mod<13>{ });
+        check(im::int_mod<1000000021>{ });
+    }
+
+    SECTION("Primes 1 mod 8")
+    {
+        check(im::int_mod<17>{ });
+        check(im::int_mod<41>{ });
+        check(im::int_mod<998244353>{ });
+        check(im::int_mod<4179340454199820289>{ });
+    }
+
+    SECTION("Small Cases")
+    {
+        REQUIRE(im::int_mod<2>{ 1 }.sqrt() == im::int_mod<2>{ 1 });
+        REQUIRE(im::int_mod<2>{ 0 }.sqrt() == im::int_mod<2>{ 0 });
+        REQUIRE_FALSE(im::int_mod<7>{ 3 }.sqrt().has_value());
+        REQUIRE(im::batch_sqrt(std::span<im::int_mod<97> const>{ }).empty());
+        REQUIRE(im::batch_sqrt(std::array<im::int_mod<13>, 2>{ 10, 5 }) == std::vector<std::optional<im::int_mod<13>>>{ 6, std::nullopt });
+
+        static_assert(*im::int_mod<13>{ 10 }.sqrt() == 6);
+        static_assert(*im::int_mod<17>{ 2 }.sqrt() == 6);
+        static_assert(!im::int_mod<1000000007>{ 5 }.sqrt().has_value());
+    }
+}
+
+TEST_CASE("Testing jacobi()")
+{
+    SECTION("Matches Euler's Criterion for Prime Moduli")
+    {
+        auto check = []<im::s64 N, typename Reduction>(im::int_mod<N, Reduction>)
+        {
+            using T = im::int_mod<N, Reduction>;
+
+            for( im::s64 i{ 0 }; i < 500; ++i )
+            {
+                T const a{ i * 104729 + i * i * 31 };
+                T const euler{ a.template pow<(N - 1) / 2>() };
+
+                REQUIRE(im::jacobi(a) == (euler == -1 ? -1 : euler.value()));
+            }
+        };
+
+        check(im::int_mod<3>{ });
+        check(im::int_mod<97>{ });
+        check(im::int_mod<998244353>{ });
+        check(im::int_mod<2147483647>{ });
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{ });
+        check(im::int_mod<4179340454199820289>{ });
+    }
+
+    SECTION("Composite Moduli")
+    {
+        // (a/15) = (a/3)(a/5).
+        constexpr std::array<int, 15> expected{ 0, 1, 1, 0, 1, 0, 0, -1, 1, 0, 0, -1, 0, -1, -1 };
+
+        for( im::s64 i{ 0 }; i < 15; ++i )
+        {
+            REQUIRE(im::jacobi(im::int_mod<15>{ i }) == expected[static_cast<std::size_t>(i)]);
+        }
+
+        static_assert(im::jacobi(im::int_mod<1000000007>{ 5 }) == -1);
+        static_assert(im::jacobi(im::int_mod<9>{ 2 }) == 1);
+        static_assert(im::jacobi(im::int_mod<21>{ 7 }) == 0);
+    }
+
+    SECTION("vector_jacobi() Matches jacobi() at Every Level")
+    {
+        std::vector<im::simd_level> levels{ im::simd_level::scalar };
+
+        if( im::detected_simd_level() != im::simd_level::scalar )
+        {
+            levels.push_back(im::simd_level::avx2);
+        }
+
+        if( im::detected_simd_level() == im::simd_level::avx512 )
+        {
+            levels.push_back(im::simd_level::avx512);
+        }
+
+        auto check = [&]<typename F>(F)
+        {
+            for( std::size_t size : { 0, 1, 8, 15, 16, 17, 100 } )
+            {
+                std::vector<F> a;
+
+                for( std::size_t i{ 0 }; i < size; ++i )
+                {
+                    a.emplace_back(static_cast<im::s64>(i * 0x9E3779B97F4A7C15u >> 1));
+                }
+
+                for( auto level : levels )
+                {
+                    std::vector<int> out(size, 2);
+                    im::vector_jacobi(a, std::span{ out }, level);
+
+                    for( std::size_t i{ 0 }; i < size; ++i ) REQUIRE(out[i] == im::jacobi(a[i]));
+                }
+            }
+        };
+
+        check(im::int_mod<998244353>{ });
+        check(im::int_mod<2147483647>{ });
+        check(im::int_mod<1337>{ });
+        check(im::int_mod<3>{ });
+        check(im::int_mod<2305843009213693951>{ });
+    }
+}
+
+TEST_CASE("Testing discrete_log()")
+{
+    auto check = []<im::s64 N, typename Reduction>(im::int_mod<N, Reduction> const g, std::size_t const max_table_entries)
+    {
+        using T = im::int_mod<N, Reduction>;
+
+        im::discrete_log_solver<N, Reduction> const solver{ g, max_table_entries };
+
+        REQUIRE(g.pow(solver.order()) == 1);
+        REQUIRE(solver.table_entries() <= std::max<std::size_t>(max_table_entries, 64));
+
+        for( im::s64 i{ 0 }; i < 20; ++i )
+        {
+            im::s64 const x{ static_cast<im::s64>(static_cast<im::u64>(i) * 0x9E3779B97F4A7C15u >> 1) % solver.order() };
+
+            REQUIRE(solver.solve(g.pow(x)) == x);
+        }
+
+        REQUIRE(solver.solve(T{ 1 }) == 0);
+        REQUIRE(solver.solve(g) == (solver.order() == 1 ? 0 : 1));
+    };
+
+    SECTION("Round Trips")
+    {
+        check(im::int_mod<97>{ 5 }, 0);
+        check(im::int_mod<998244353>{ 3 }, 1 << 20);
+        check(im::int_mod<1000000007>{ 5 }, 1 << 20);
+        check(im::int_mod<2305843009213693951>{ 37 }, 1 << 20);
+        check(im::int_mod<2305843009213693951, im::barrett_reduction>{ 37 }, 1 << 20);
+        check(im::int_mod<1000000000>{ 3 }, 1 << 20);
+        check(im::int_mod<1000000007>{ 4 }, 1 << 20);
+    }
+
+    SECTION("Pollard's Rho Without Tables")
+    {
+        // 1000000006 = 2 * 500000003.
+        check(im::int_mod<1000000007>{ 5 }, 0);
+        check(im::int_mod<1000000007>{ 5 }, 100);
+
+        // 4179340454199820288 = 2^57 * 29.
+        check(im::int_mod<4179340454199820289>{ 3 }, 0);
+    }
+
+    SECTION("Least Solution")
+    {
+        // 2 has order 11 modulo 23.
+        im::discrete_log_solver<23> const solver{ im::int_mod<23>{ 2 } };
+
+        REQUIRE(solver.order() == 11);
+        REQUIRE(solver.solve(im::int_mod<23>{ 2 }.pow(100)) == 100 % 11);
+        REQUIRE(im::discrete_log(im::int_mod<1000000007>{ 5 }, im::int_mod<1000000007>{ 5 }.pow(123456789)) == 123456789);
+    }
+
+    SECTION("No Solution")
+    {
+        // 4 is a square modulo 1000000007 and 5 is not.
+        REQUIRE_FALSE(im::discrete_log(im::int_mod<1000000007>{ 4 }, im::int_mod<1000000007>{ 5 }).has_value());
+        REQUIRE_FALSE(im::discrete_log(im::int_mod<1000000007>{ 4 }, im::int_mod<1000000007>{ 5 }, 0).has_value());
+        REQUIRE_FALSE(im::discrete_log(im::int_mod<1000000007>{ 5 }, im::int_mod<1000000007>{ 0 }).has_value());
+
+        // 11^2 = 1 modulo 15, but the powers of 2 are 1, 2, 4 and 8.
+        REQUIRE_FALSE(im::discrete_log(im::int_mod<15>{ 2 }, im::int_mod<15>{ 11 }).has_value());
+        REQUIRE(im::discrete_log(im::int_mod<15>{ 2 }, im::int_mod<15>{ 8 }) == 3);
+    }
+
+    SECTION("Base Must Be a Unit")
+    {
+        try
+        {
+            im::discrete_log(im::int_mod<15>{ 6 }, im::int_mod<15>{ 6 });
+            REQUIRE(false);
+        }
+        catch( std::invalid_argument const &e )
+        {
+            REQUIRE(std::string(e.what()) == "Base 6 of discrete_log_solver is not a unit modulo 15.\n");
+        }
+    }
+}